@@ -10,8 +10,11 @@
 #include "../utils/utils.hpp"
 #include <iostream>
 #include <assert.h>
+#include <cmath>
 using namespace std;
 
+#define MAX_STATIC_TABLE_SIZE	(1 << 22)		// Maximum number of entries of a dense table of a static function
+
 //#define _GROUNDER_TRACE_ON_
 
 /********************************************************/
@@ -36,9 +39,11 @@ void GrounderOperator::initialize(Operator &o) {
     if (numParams > 0) {
         paramValues = new vector<unsigned int>[numParams];
         compatibleObjectsWithParam = new vector<unsigned int>[numParams];
+        compatibleObjectBits = new vector<uint64_t>[numParams];
     } else {
         paramValues = nullptr;
         compatibleObjectsWithParam = nullptr;
+        compatibleObjectBits = nullptr;
     }
     
     for (unsigned int i = 0; i < o.atStart.prec.size(); i++)
@@ -47,6 +52,17 @@ void GrounderOperator::initialize(Operator &o) {
         preconditions.emplace_back(o.overAllPrec[i]);
 }
 
+// Initializes the operator as a copy of another one, with no parameters bound
+void GrounderOperator::initialize(GrounderOperator &o) {
+    initialize(*(o.op));
+    index = o.index;
+    nameIndex = o.nameIndex;
+    for (unsigned int i = 0; i < numParams; i++) {
+        compatibleObjectsWithParam[i] = o.compatibleObjectsWithParam[i];
+        compatibleObjectBits[i] = o.compatibleObjectBits[i];
+    }
+}
+
 GrounderOperator::~GrounderOperator() {
     if (paramValues != nullptr) {
         delete[] paramValues;
@@ -54,6 +70,9 @@ GrounderOperator::~GrounderOperator() {
     if (compatibleObjectsWithParam != nullptr) {
         delete[] compatibleObjectsWithParam;
     }
+    if (compatibleObjectBits != nullptr) {
+        delete[] compatibleObjectBits;
+    }
 }
 
 /********************************************************/
@@ -66,33 +85,105 @@ ProgrammedValue::ProgrammedValue(unsigned int index, unsigned int varIndex, unsi
     this->valueIndex = valueIndex;
 }
 
+/********************************************************/
+/* CLASS: GrounderTupleIndex                            */
+/********************************************************/
+
+// Hash code of a key
+uint64_t GrounderTupleIndex::hash(const vector<unsigned int> &key) {
+    uint64_t h = 14695981039346656037ULL;
+    for (unsigned int i = 0; i < key.size(); i++)
+        h = (h ^ key[i]) * 1099511628211ULL;
+    return h ^ (h >> 32);
+}
+
+// Returns the slot of the key, or the empty slot where it should be inserted
+unsigned int GrounderTupleIndex::findSlot(const vector<unsigned int> &key) {
+    unsigned int mask = slots.size() - 1, s = hash(key) & mask;
+    while (slots[s].first != MAX_UNSIGNED_INT) {
+        const unsigned int* t = tuples.data() + slots[s].first;
+        if (t[0] == key.size()) {
+            unsigned int i = 0;
+            while (i < key.size() && t[i + 1] == key[i]) i++;
+            if (i == key.size()) return s;
+        }
+        s = (s + 1) & mask;
+    }
+    return s;
+}
+
+// Doubles the number of slots
+void GrounderTupleIndex::grow() {
+    vector<pair<unsigned int, unsigned int>> old(slots.empty() ? 32 : slots.size() * 2, make_pair(MAX_UNSIGNED_INT, 0U));
+    old.swap(slots);
+    unsigned int mask = slots.size() - 1;
+    vector<unsigned int> k;
+    for (unsigned int i = 0; i < old.size(); i++) {
+        if (old[i].first == MAX_UNSIGNED_INT) continue;
+        const unsigned int* t = tuples.data() + old[i].first;
+        k.assign(t + 1, t + 1 + t[0]);
+        unsigned int s = hash(k) & mask;
+        while (slots[s].first != MAX_UNSIGNED_INT) s = (s + 1) & mask;
+        slots[s] = old[i];
+    }
+}
+
+// Returns the value of the key, or MAX_UNSIGNED_INT if it is not in the index
+unsigned int GrounderTupleIndex::find(const vector<unsigned int> &key) {
+    if (count == 0) return MAX_UNSIGNED_INT;
+    unsigned int s = findSlot(key);
+    return slots[s].first == MAX_UNSIGNED_INT ? MAX_UNSIGNED_INT : slots[s].second;
+}
+
+// Sets the value of the key
+void GrounderTupleIndex::insert(const vector<unsigned int> &key, unsigned int value) {
+    if (2 * (count + 1) > slots.size()) grow();
+    unsigned int s = findSlot(key);
+    if (slots[s].first == MAX_UNSIGNED_INT) {
+        slots[s].first = tuples.size();
+        tuples.push_back(key.size());
+        tuples.insert(tuples.end(), key.begin(), key.end());
+        count++;
+    }
+    slots[s].second = value;
+}
+
+// Removes all the keys
+void GrounderTupleIndex::clear() {
+    tuples.clear();
+    slots.clear();
+    count = 0;
+}
+
 /********************************************************/
 /* CLASS: Grounder                                      */
 /********************************************************/
 
 // Grounding process
-GroundedTask* Grounder::groundTask(PreprocessedTask *prepTask, bool keepStaticData) {
+GroundedTask* Grounder::groundTask(PreprocessedTask *prepTask, bool keepStaticData, bool pruneIrrelevant) {
     currentLevel = 0;
+    numIrrelevantActions = 0;
+    numIrrelevantVariables = 0;
     this->prepTask = prepTask;
     gTask = new GroundedTask(prepTask->task);
     initTypesMatrix();
     initOperators();
     initInitialState();
+    if (!keepStaticData) initStaticFunctions();
     for (unsigned int i = 0; i < numOps; i++) {
         Operator *op = ops[i].op;
         if (op->atStart.prec.size() == 0 && op->overAllPrec.size() == 0)
-            groundRemainingParameters(ops[i]);
+            groundRemainingParameters(ops[i], nullptr);
     }
     // Program the facts in the initial state
     for (unsigned int i = 0; i < auxValues->size(); i++) {
         ProgrammedValue &pv = auxValues->at(i);
         newValues->push_back(pv);
-        valuesByFunction[gTask->variables[pv.varIndex].fncIndex].push_back(pv);
+        addReachedValue(pv);
     }
     auxValues->clear();
     while (newValues->size() > 0) {
-        for (unsigned int i = 0; i < newValues->size(); i++)
-            match(newValues->at(i));
+        matchNewValues();
         startNewValues += newValues->size();
         swapLevels();
         currentLevel++;
@@ -105,42 +196,151 @@ GroundedTask* Grounder::groundTask(PreprocessedTask *prepTask, bool keepStaticDa
     	gTask->metric = groundMetric(&(gTask->task->metric));
     }
 	if (!keepStaticData) {
-		removeStaticVariables();
+		removeStaticVariables();		// Also checks the numeric conditions of the actions
+	}
+	else checkNumericConditions();
+	if (pruneIrrelevant) {
+		removeIrrelevantData();
 	}
-	checkNumericConditions();
     computeInitialVariableValues();
     clearMemory();
     return gTask;    
 }
 
-// Creates the matrix of types for a fast checking of types compatibility
+// Estimates the number of ground actions as the number of type-compatible instantiations of the operators,
+// without grounding the task. It is an upper bound, as static preconditions are not taken into account.
+// Goal operators are not counted, as they do not become actions of the task
+double Grounder::estimateNumActions(PreprocessedTask *prepTask) {
+    this->prepTask = prepTask;
+    initTypesMatrix();
+    initOperators();
+    double numActions = 0;
+    for (unsigned int i = 0; i < numOps; i++) {
+        if (ops[i].op->isGoal) continue;
+        double numInstances = 1;
+        for (unsigned int j = 0; j < ops[i].numParams; j++)
+            numInstances *= ops[i].compatibleObjectsWithParam[j].size();
+        numActions += numInstances;
+    }
+    delete[] opRequireFunction;
+    delete[] ops;
+    objectsOfType.clear();
+    return numActions;
+}
+
+// Creates the bit sets of objects of each type for a fast checking of types compatibility
 void Grounder::initTypesMatrix() {
     unsigned int numTypes = prepTask->task->types.size();
-    typesMatrix = new bool*[numTypes];
+    unsigned int numObjects = prepTask->task->objects.size();
+    bool **typesMatrix = new bool*[numTypes];
     for (unsigned int i = 0; i < numTypes; i++)
         typesMatrix[i] = new bool[numTypes]();
     for (unsigned int i = 0; i < numTypes; i++)
-        addTypeToMatrix(i, i);
+        addTypeToMatrix(typesMatrix, i, i);
+    objectsOfType.assign(numTypes, vector<uint64_t>((numObjects + 63) >> 6, 0));
+    for (unsigned int k = 0; k < numObjects; k++) {
+        vector<unsigned int> &v = prepTask->task->objects[k].types;
+        for (unsigned int i = 0; i < v.size(); i++)
+            for (unsigned int t = 0; t < numTypes; t++)
+                if (typesMatrix[v[i]][t])
+                    objectsOfType[t][k >> 6] |= 1ULL << (k & 63);
+    }
+    for (unsigned int i = 0; i < numTypes; i++)
+        delete[] typesMatrix[i];
+    delete[] typesMatrix;
+}
+
+// Creates the tables of values of the static numeric functions, so their values are directly loaded while
+// grounding. A function is stored in a dense array indexed by the tuple of objects if it is not too large
+void Grounder::initStaticFunctions() {
+    ParsedTask* task = prepTask->task;
+    unsigned int numFunctions = task->functions.size();
+    staticFunctions.assign(numFunctions, GrounderStaticFunction());
+    for (unsigned int i = 0; i < numFunctions; i++)
+        staticFunctions[i].isStatic = task->isNumericFunction(i);
+    for (unsigned int i = 0; i < prepTask->operators.size(); i++) {
+        Operator &op = prepTask->operators[i];
+        for (unsigned int j = 0; j < op.atStart.numericEff.size(); j++)
+            staticFunctions[op.atStart.numericEff[j].fluent.fncIndex].isStatic = false;
+        for (unsigned int j = 0; j < op.atEnd.numericEff.size(); j++)
+            staticFunctions[op.atEnd.numericEff[j].fluent.fncIndex].isStatic = false;
+    }
+    vector<unsigned int> numFacts(numFunctions, 0);
+    for (unsigned int i = 0; i < task->init.size(); i++) {
+        Fact &f = task->init[i];
+        if (f.time > 0 || !f.valueIsNumeric) staticFunctions[f.function].isStatic = false;     // TIL are not static
+        else numFacts[f.function]++;
+    }
+    uint64_t numObjects = task->objects.size();
+    for (unsigned int i = 0; i < numFunctions; i++) {
+        GrounderStaticFunction &sf = staticFunctions[i];
+        if (!sf.isStatic) continue;
+        uint64_t size = 1;
+        for (unsigned int j = 0; j < task->functions[i].parameters.size() && size <= MAX_STATIC_TABLE_SIZE; j++)
+            size *= numObjects;
+        sf.dense = size <= MAX_STATIC_TABLE_SIZE && size <= 64 * (uint64_t) numFacts[i] + 1024;
+        if (sf.dense) sf.values.assign(size, NAN);
+    }
+    for (unsigned int i = 0; i < task->init.size(); i++) {
+        Fact &f = task->init[i];
+        GrounderStaticFunction &sf = staticFunctions[f.function];
+        if (!sf.isStatic) continue;
+        unsigned int pos;
+        if (sf.dense) {
+            uint64_t p = 0;
+            for (unsigned int j = 0; j < f.parameters.size(); j++)
+                p = p * numObjects + f.parameters[j];
+            pos = (unsigned int) p;
+        } else {
+            const vector<unsigned int> &k = getVariableKey(f.function, f.parameters);
+            pos = sf.index.find(k);
+            if (pos == MAX_UNSIGNED_INT) {
+                pos = sf.values.size();
+                sf.index.insert(k, pos);
+                sf.values.push_back(NAN);
+            }
+        }
+        if (std::isnan(sf.values[pos])) sf.values[pos] = f.numericValue;
+        else sf.isStatic = false;       // Several initial values: handled as a regular variable
+    }
+}
+
+// Returns the value of a static function for the given parameters, or NaN if it is undefined
+float Grounder::getStaticValue(const Literal &l, const vector<unsigned int> &opParameters) {
+    GrounderStaticFunction &sf = staticFunctions[l.fncIndex];
+    if (sf.dense) {
+        uint64_t numObjects = prepTask->task->objects.size(), p = 0;
+        for (unsigned int i = 0; i < l.params.size(); i++)
+            p = p * numObjects + (l.params[i].isVariable ? opParameters[l.params[i].index] : l.params[i].index);
+        return sf.values[p];
+    }
+    unsigned int pos = sf.index.find(getVariableKey(l, opParameters));
+    return pos == MAX_UNSIGNED_INT ? NAN : sf.values[pos];
 }
 
 // Deletes the allocated memory
 void Grounder::clearMemory() {
-    for (unsigned int i = 0; i < prepTask->task->types.size(); i++)
-        delete[] typesMatrix[i];
-    delete[] typesMatrix;
+    objectsOfType.clear();
+    staticFunctions.clear();
     delete[] opRequireFunction;
+    for (unsigned int i = 1; i < threadOps.size(); i++)
+        delete[] threadOps[i];
+    threadOps.clear();
     delete[] ops;
     delete[] valuesByFunction;
     delete newValues;
     delete auxValues;
+    valuesByArgument.clear();
+    variableIndex.clear();
+    groundedActions.clear();
 }
 
 // Recursively initializes the matrix of types
-void Grounder::addTypeToMatrix(unsigned int typeIndex, unsigned int subtypeIndex) {
+void Grounder::addTypeToMatrix(bool **typesMatrix, unsigned int typeIndex, unsigned int subtypeIndex) {
     typesMatrix[typeIndex][subtypeIndex] = true;
     Type &t = prepTask->task->types[subtypeIndex];
     for (unsigned int i = 0; i < t.parentTypes.size(); i++)
-        addTypeToMatrix(typeIndex, t.parentTypes[i]);
+        addTypeToMatrix(typesMatrix, typeIndex, t.parentTypes[i]);
 }
 
 // Initializes the operators for grounding
@@ -148,13 +348,23 @@ void Grounder::initOperators() {
     numOps = prepTask->operators.size();
     ops = new GrounderOperator[numOps];
     unsigned int numObjects = prepTask->task->objects.size();
+    unordered_map<string, unsigned int> opNames;
     for (unsigned int i = 0; i < numOps; i++) {
         GrounderOperator &g = ops[i];
         g.initialize(prepTask->operators[i]);
-        for (unsigned int j = 0; j < g.numParams; j++)
+        g.index = i;
+        g.nameIndex = opNames.emplace(g.op->name, opNames.size()).first->second;
+        for (unsigned int j = 0; j < g.numParams; j++) {
+            vector<unsigned int> &types = g.op->parameters[j].types;
+            vector<uint64_t> &bits = g.compatibleObjectBits[j];
+            bits.assign((numObjects + 63) >> 6, 0);
+            for (unsigned int t = 0; t < types.size(); t++)
+                for (unsigned int w = 0; w < bits.size(); w++)
+                    bits[w] |= objectsOfType[types[t]][w];
             for (unsigned int k = 0; k < numObjects; k++)
-                if (objectIsCompatible(k, g.op->parameters[j].types))
+                if (g.isCompatible(j, k))
                     g.compatibleObjectsWithParam[j].push_back(k);
+        }
     }
     unsigned int numFunctions = prepTask->task->functions.size();
     opRequireFunction = new vector<GrounderOperator*>[numFunctions];
@@ -195,7 +405,7 @@ void Grounder::initInitialState() {
         if (!f.valueIsNumeric) {    // Program only non-numeric variables
             ProgrammedValue pv(numValues++, getVariableIndex(f), f.value);
             newValues->push_back(pv);
-            valuesByFunction[f.function].push_back(pv);
+            addReachedValue(pv);
             gTask->reachedValues[pv.varIndex][pv.valueIndex] = 0;
         }
     }
@@ -204,15 +414,15 @@ void Grounder::initInitialState() {
 
 // Creates a new variable
 void Grounder::createVariable(const Fact &f) {
-    string factName = getVariableName(f.function, f.parameters);
-    if (variableIndex.find(factName) == variableIndex.end()) { // New variable
+    const vector<unsigned int> &factKey = getVariableKey(f.function, f.parameters);
+    if (variableIndex.find(factKey) == MAX_UNSIGNED_INT) {    // New variable
         GroundedVar v;
         v.index = gTask->variables.size();
         v.fncIndex = f.function;
         v.isNumeric = f.valueIsNumeric;
         v.params = f.parameters;
         gTask->variables.push_back(v);
-        variableIndex[factName] = v.index;
+        variableIndex.insert(factKey, v.index);
         unsigned int notReached = MAX_UNSIGNED_INT;
         if (v.isNumeric) gTask->reachedValues.emplace_back(0, notReached);
         else {
@@ -223,40 +433,39 @@ void Grounder::createVariable(const Fact &f) {
     }
 }
 
-// Returns the description of a variable
-string Grounder::getVariableName(unsigned int function, const vector<unsigned int> &parameters) {
-    string name = to_string(function);
-    for (unsigned int i = 0; i < parameters.size(); i++)
-        name += " " + to_string(parameters[i]);
-    return name;
+// Returns the key of a variable: the function followed by the parameters. The key is built in a shared buffer
+const vector<unsigned int>& Grounder::getVariableKey(unsigned int function, const vector<unsigned int> &parameters) {
+    key.clear();
+    key.push_back(function);
+    key.insert(key.end(), parameters.begin(), parameters.end());
+    return key;
 }
 
-// Returns the description of a literal
-string Grounder::getVariableName(const Literal &l, const vector<unsigned int> &opParameters) {
-    string name = to_string(l.fncIndex);
+// Returns the key of a literal. The key is built in a shared buffer
+const vector<unsigned int>& Grounder::getVariableKey(const Literal &l, const vector<unsigned int> &opParameters) {
+    key.clear();
+    key.push_back(l.fncIndex);
     for (unsigned int i = 0; i < l.params.size(); i++)
         if (l.params[i].isVariable)
-           name += " " + to_string(opParameters[l.params[i].index]);
+           key.push_back(opParameters[l.params[i].index]);
         else
-           name += " " + to_string(l.params[i].index);
-    return name;
+           key.push_back(l.params[i].index);
+    return key;
 }
     
 // Returns the index of a variable
 unsigned int Grounder::getVariableIndex(const Fact &f) {
-    return variableIndex[getVariableName(f.function, f.parameters)];
+    return variableIndex.find(getVariableKey(f.function, f.parameters));
 }
 
 // Returns the index of a variable
 unsigned int Grounder::getVariableIndex(const Literal &l, const vector<unsigned int> &opParameters) {
-    const string &name = getVariableName(l, opParameters);
-    unordered_map<string,unsigned int>::const_iterator it = variableIndex.find(name);
-    if (it == variableIndex.end()) return MAX_UNSIGNED_INT;
-    else return it->second;
+    return variableIndex.find(getVariableKey(l, opParameters));
 }
 
-// Grounding by combining all posible values for the parameters
-void Grounder::groundRemainingParameters(GrounderOperator &op) {
+// Grounding by combining all posible values for the parameters. If bindings is not null, the
+// action is not grounded: the operator index and the parameter values are appended to bindings
+void Grounder::groundRemainingParameters(GrounderOperator &op, vector<unsigned int>* bindings) {
     unsigned int pIndex = MAX_UNSIGNED_INT;
     for (unsigned int i = 0; i < op.numParams; i++)
         if (op.paramValues[i].size() == 0) {
@@ -264,12 +473,17 @@ void Grounder::groundRemainingParameters(GrounderOperator &op) {
             break;
         }
     if (pIndex == MAX_UNSIGNED_INT) {
-        groundAction(op);
+        if (bindings == nullptr) groundAction(op);
+        else {
+            bindings->push_back(op.index);
+            for (unsigned int i = 0; i < op.numParams; i++)
+                bindings->push_back(op.paramValues[i].back());
+        }
     } else {
         vector<unsigned int> &v = op.compatibleObjectsWithParam[pIndex];
         for (unsigned int i = 0; i < v.size(); i++) {
             op.paramValues[pIndex].push_back(v[i]);
-            groundRemainingParameters(op);
+            groundRemainingParameters(op, bindings);
             op.paramValues[pIndex].pop_back();
         }
     }
@@ -284,9 +498,11 @@ void Grounder::groundAction(GrounderOperator &op) {
         a.parameters.push_back(op.paramValues[i].back());
     }
 	if (!op.op->isGoal) {
-		std::string name = a.getName(gTask->task);
-		if (groundedActions.find(name) != groundedActions.end()) return;	// Repeated action
-		groundedActions[name] = a.index;
+		key.clear();
+		key.push_back(op.nameIndex);
+		key.insert(key.end(), a.parameters.begin(), a.parameters.end());
+		if (groundedActions.find(key) != MAX_UNSIGNED_INT) return;	// Repeated action
+		groundedActions.insert(key, a.index);
 	}
     if (!checkEqualityConditions(op, a)) return;
     if (!groundPreconditions(op, a)) return;
@@ -314,24 +530,11 @@ void Grounder::programNewValue(GroundedCondition &eff) {
     }
 }
 
-// Checks if the given object is compatible with the given types
-bool Grounder::objectIsCompatible(unsigned int objIndex, vector<unsigned int> &types) {
-    vector<unsigned int> &v = prepTask->task->objects[objIndex].types;
-    for (unsigned int i = 0; i < v.size(); i++) {
-        unsigned int t = v[i];
-        for (unsigned int j = 0; j < types.size(); j++) {
-            if (typesMatrix[t][types[j]])
-                return true;
-        }
-    }
-    return false;
-}
-
 // Checks whether a programmed value matches one of the preconditions of the operators
-void Grounder::match(ProgrammedValue &pv) {
+void Grounder::match(ProgrammedValue &pv, GrounderOperator* opSet, vector<unsigned int>* bindings) {
     vector<GrounderOperator*> &rf = opRequireFunction[gTask->variables[pv.varIndex].fncIndex];
     for (unsigned int i = 0; i < rf.size(); i++) {
-        GrounderOperator* op = rf[i];
+        GrounderOperator* op = opSet + rf[i]->index;
         int precIndex = -1;
 #ifdef _GROUNDER_TRACE_ON_
 		if (op->op->name.compare("inspect") == 0)
@@ -346,19 +549,75 @@ void Grounder::match(ProgrammedValue &pv) {
 #endif				
 				op->newValueIndex = pv.index;
                 stackParameters(op, precIndex, pv.varIndex, pv.valueIndex);
-                completeMatch(op, 0);
+                completeMatch(op, 0, bindings);
                 unstackParameters(op, precIndex);
             }
         } while (precIndex != -1);
     }
 }
 
+// Adds a value to the list of values of its function and to the indexes of its arguments.
+// The value (object) is indexed as the last argument
+void Grounder::addReachedValue(ProgrammedValue &pv) {
+    GroundedVar &v = gTask->variables[pv.varIndex];
+    vector<ProgrammedValue> &vf = valuesByFunction[v.fncIndex];
+    unsigned int position = vf.size();
+    vf.push_back(pv);
+    for (unsigned int i = 0; i < v.params.size(); i++)
+        valuesByArgument[getArgumentKey(v.fncIndex, i, v.params[i])].push_back(position);
+    valuesByArgument[getArgumentKey(v.fncIndex, v.params.size(), pv.valueIndex)].push_back(position);
+}
+
+// Matches the values reached in the last level with the operator preconditions. With several threads, each one
+// collects the parameter bindings of its values and the actions are then grounded in the sequential order, so
+// the indexes of the actions and variables do not depend on the number of threads
+void Grounder::matchNewValues() {
+    unsigned int numThreads = getNumThreads(newValues->size());
+    if (numThreads <= 1) {
+        for (unsigned int i = 0; i < newValues->size(); i++)
+            match(newValues->at(i), ops, nullptr);
+        return;
+    }
+    if (threadOps.empty()) threadOps.push_back(ops);
+    while (threadOps.size() < numThreads) {
+        GrounderOperator* copy = new GrounderOperator[numOps];
+        for (unsigned int i = 0; i < numOps; i++)
+            copy[i].initialize(ops[i]);
+        threadOps.push_back(copy);
+    }
+    vector<vector<unsigned int>> bindings(newValues->size());
+    vector<thread> threads;
+    for (unsigned int t = 1; t < numThreads; t++)
+        threads.emplace_back(&Grounder::matchValues, this, &bindings, t, numThreads);
+    matchValues(&bindings, 0, numThreads);
+    for (unsigned int t = 0; t < threads.size(); t++)
+        threads[t].join();
+    for (unsigned int i = 0; i < bindings.size(); i++) {
+        vector<unsigned int> &b = bindings[i];
+        unsigned int j = 0;
+        while (j < b.size()) {
+            GrounderOperator &op = ops[b[j++]];
+            for (unsigned int k = 0; k < op.numParams; k++)
+                op.paramValues[k].push_back(b[j++]);
+            groundAction(op);
+            for (unsigned int k = 0; k < op.numParams; k++)
+                op.paramValues[k].pop_back();
+        }
+        vector<unsigned int>().swap(b);
+    }
+}
+
+// Matches the new values assigned to a thread (from first, with the given step) using the thread's copy of the operators
+void Grounder::matchValues(vector<vector<unsigned int>>* bindings, unsigned int first, unsigned int step) {
+    GrounderOperator* opSet = threadOps[first];
+    for (unsigned int i = first; i < newValues->size(); i += step)
+        match(newValues->at(i), opSet, &(bindings->at(i)));
+}
+
 // Exchanges the levels of programmed values (newValues <-> auxValues)
 void Grounder::swapLevels() {
-    for (unsigned int i = 0; i < auxValues->size(); i++) {
-        ProgrammedValue &pv = auxValues->at(i);
-        valuesByFunction[gTask->variables[pv.varIndex].fncIndex].push_back(pv);
-    }
+    for (unsigned int i = 0; i < auxValues->size(); i++)
+        addReachedValue(auxValues->at(i));
     vector<ProgrammedValue> *aux = newValues;
     newValues = auxValues;
     auxValues = aux;
@@ -415,7 +674,7 @@ bool Grounder::precMatches(GrounderOperator *op, GrounderAssignment &p, unsigned
          if (p.params->at(i).isVariable) {  // Parameter
             vector<unsigned int> &paramValues = op->paramValues[paramIndex];
             if (paramValues.size() == 0) {    // Ungrounded parameter, types should match
-               if (!objectIsCompatible(v.params[i], op->op->parameters[paramIndex].types)) {
+               if (!op->isCompatible(paramIndex, v.params[i])) {
                   return false;
                }
             } else {                          // Grounded parameter, objects must coincide
@@ -433,7 +692,7 @@ bool Grounder::precMatches(GrounderOperator *op, GrounderAssignment &p, unsigned
      if (p.value->isVariable) {             // Parameter
         vector<unsigned int> &paramValues = op->paramValues[paramIndex];
         if (paramValues.size() == 0) {    // Ungrounded parameter, types should match
-           return objectIsCompatible(valueIndex, op->op->parameters[paramIndex].types);
+           return op->isCompatible(paramIndex, valueIndex);
         } else {                          // Grounded parameter, objects must coincide
            return paramValues.back() == valueIndex;
         }
@@ -443,7 +702,7 @@ bool Grounder::precMatches(GrounderOperator *op, GrounderAssignment &p, unsigned
 }
 
 // Completes the operator matching process
-void Grounder::completeMatch(GrounderOperator *op, unsigned int precIndex) {
+void Grounder::completeMatch(GrounderOperator *op, unsigned int precIndex, vector<unsigned int>* bindings) {
 	 GrounderAssignment *p = nullptr;
      while (precIndex < op->preconditions.size()) {
            p = &(op->preconditions[precIndex]);
@@ -463,32 +722,60 @@ void Grounder::completeMatch(GrounderOperator *op, unsigned int precIndex) {
 #ifdef _GROUNDER_TRACE_ON_
 		 cout << "All preconditions gounded" << endl;
 #endif
-		 groundRemainingParameters(*op);
+		 groundRemainingParameters(*op, bindings);
      } else {                                      // Continue with the precondition matching
 #ifdef _GROUNDER_TRACE_ON_
 		 cout << "Trying to ground precondition " << precIndex << ": " << gTask->task->functions[op->preconditions[precIndex].fncIndex].name << endl;
 #endif
 		vector<ProgrammedValue> &vf = valuesByFunction[p->fncIndex];
-        for (unsigned int i = 0; i < vf.size(); i++) {
-            ProgrammedValue &pv = vf[i];
+		const vector<unsigned int>* candidates = getCandidateValues(op, *p);
+		if (candidates == nullptr) {
+			for (unsigned int i = 0; i < vf.size(); i++)
+				matchValue(op, precIndex, vf[i], bindings);
+		} else {
+			for (unsigned int i = 0; i < candidates->size(); i++)
+				matchValue(op, precIndex, vf[(*candidates)[i]], bindings);
+		}
+     }
 #ifdef _GROUNDER_TRACE_ON_
-			cout << "    Testing " << gTask->variables[pv.varIndex].toString(gTask->task) << "=" << gTask->task->objects[pv.valueIndex].name << endl;
-			cout << "    pv.index = " << pv.index << ", startNewValues = " << startNewValues << ", op->newValueIndex = " << op->newValueIndex << endl;
+	 cout << "Finishing" << endl;
 #endif
-			if ((pv.index < startNewValues || pv.index >= op->newValueIndex)
-               && precMatches(op, *p, pv.varIndex, pv.valueIndex)) {
+}
+
+// Returns the positions in valuesByFunction of the values that can match the precondition, taken from the
+// index of its most selective argument bound to an object. Returns nullptr if there are no bound arguments
+const vector<unsigned int>* Grounder::getCandidateValues(GrounderOperator *op, GrounderAssignment &p) {
+	const vector<unsigned int>* best = nullptr;
+	unsigned int numArgs = p.params->size();
+	for (unsigned int i = 0; i <= numArgs; i++) {
+		Term &t = i < numArgs ? p.params->at(i) : *(p.value);
+		unsigned int object = t.index;
+		if (t.isVariable) {
+			if (op->paramValues[t.index].empty()) continue;
+			object = op->paramValues[t.index].back();
+		}
+		unordered_map<uint64_t, vector<unsigned int>>::const_iterator it = valuesByArgument.find(getArgumentKey(p.fncIndex, i, object));
+		if (it == valuesByArgument.end()) return &noValues;
+		if (best == nullptr || it->second.size() < best->size()) best = &(it->second);
+	}
+	return best;
+}
+
+// Tries to match the precondition with a value of the current or a previous level
+void Grounder::matchValue(GrounderOperator *op, unsigned int precIndex, ProgrammedValue &pv, vector<unsigned int>* bindings) {
 #ifdef _GROUNDER_TRACE_ON_
-				cout << "    Match found with " << gTask->variables[pv.varIndex].toString(gTask->task) << "=" << gTask->task->objects[pv.valueIndex].name << endl;
+	cout << "    Testing " << gTask->variables[pv.varIndex].toString(gTask->task) << "=" << gTask->task->objects[pv.valueIndex].name << endl;
+	cout << "    pv.index = " << pv.index << ", startNewValues = " << startNewValues << ", op->newValueIndex = " << op->newValueIndex << endl;
 #endif
-				stackParameters(op, precIndex, pv.varIndex, pv.valueIndex);
-                completeMatch(op, precIndex + 1);
-                unstackParameters(op, precIndex);
-            }
-        }
-     }
+	if ((pv.index < startNewValues || pv.index >= op->newValueIndex)
+		&& precMatches(op, op->preconditions[precIndex], pv.varIndex, pv.valueIndex)) {
 #ifdef _GROUNDER_TRACE_ON_
-	 cout << "Finishing" << endl;
+		cout << "    Match found with " << gTask->variables[pv.varIndex].toString(gTask->task) << "=" << gTask->task->objects[pv.valueIndex].name << endl;
 #endif
+		stackParameters(op, precIndex, pv.varIndex, pv.valueIndex);
+		completeMatch(op, precIndex + 1, bindings);
+		unstackParameters(op, precIndex);
+	}
 }
 
 // Check equality conditions
@@ -582,8 +869,7 @@ unsigned int Grounder::createNewVariable(const Literal &l, const vector<unsigned
         if (l.params[i].isVariable) v.params.push_back(opParameters[l.params[i].index]);
         else v.params.push_back(l.params[i].index);
     gTask->variables.push_back(v);
-    const string &name = getVariableName(v.fncIndex, v.params);
-    variableIndex[name] = v.index;
+    variableIndex.insert(getVariableKey(v.fncIndex, v.params), v.index);
     unsigned int notReached = MAX_UNSIGNED_INT;
     if (v.isNumeric) gTask->reachedValues.emplace_back(0, notReached);
     else gTask->reachedValues.emplace_back(prepTask->task->objects.size(), notReached);
@@ -615,6 +901,11 @@ GroundedNumericExpression Grounder::groundNumericExpression(OpEffectExpression &
          res.value = exp.value;
          break;
     case OEET_FLUENT:
+         if (!staticFunctions.empty() && staticFunctions[exp.fluent.fncIndex].isStatic) {
+             res.value = getStaticValue(exp.fluent, parameters);
+             res.type = std::isnan(res.value) ? GE_UNDEFINED : GE_NUMBER;
+             break;
+         }
          res.type = GE_VAR;
          res.index = getVariableIndex(exp.fluent, parameters);
 		 if (res.index == MAX_UNSIGNED_INT)      // New variable
@@ -757,6 +1048,11 @@ GroundedNumericExpression Grounder::groundNumericExpression(NumericExpression &e
          res.value = exp.value;
          break;
     case NET_FUNCTION:
+         if (!staticFunctions.empty() && staticFunctions[exp.function.fncIndex].isStatic) {
+             res.value = getStaticValue(exp.function, parameters);
+             res.type = std::isnan(res.value) ? GE_UNDEFINED : GE_NUMBER;
+             break;
+         }
          res.type = GE_VAR;
          res.index = getVariableIndex(exp.function, parameters);
 		 if (res.index == MAX_UNSIGNED_INT)      // New variable
@@ -885,6 +1181,13 @@ PartiallyGroundedNumericExpression Grounder::partiallyGroundNumericExpression(Nu
          break;
     case NET_FUNCTION:
          if (canGroundVariable(exp.function, parameters.size())) {
+             if (!staticFunctions.empty() && staticFunctions[exp.function.fncIndex].isStatic) {
+                 res.value = getStaticValue(exp.function, parameters);
+                 if (!std::isnan(res.value)) {
+                     res.type = PGE_NUMBER;
+                     break;
+                 }
+             }
              res.type = PGE_VAR;
              res.index = getVariableIndex(exp.function, parameters);
              if (res.index == MAX_UNSIGNED_INT)      // New variable
@@ -928,11 +1231,12 @@ void Grounder::removeStaticVariables() {
      vector<VariableValue> value;
      for (unsigned int i = 0; i < numActions; i++)
          checkStaticVariables(gTask->actions[i], staticVar);
+     vector< vector<Fact*> > varInitValues;
+     getInitialValues(varInitValues);
      unsigned int index = 0;
      for (unsigned int i = 0; i < numVars; i++) {
          if (staticVar[i]) {
-            vector<Fact*> initValues;      // Initial values for this variable. Can be multiple due to the time-initial literals (TIL)
-            getInitialValues(i, initValues);
+            vector<Fact*> &initValues = varInitValues[i];  // Can be multiple due to the time-initial literals (TIL)
             VariableValue v;
             if (initValues.size() > 1) staticVar[i] = false; // TIL are not static
             else if (initValues.size() == 0) {               // Check if function is boolean. In that case the initial value is false
@@ -970,7 +1274,7 @@ void Grounder::removeStaticVariables() {
              index++;
          }
      }
-     removeStaticVariables(staticVar, newIndex, value);
+     removeStaticVariables(staticVar, newIndex, value, true);
 	 for (unsigned int i = 0; i < gTask->variables.size(); i++) {
 		 gTask->variables[i].index = i;
 	 }
@@ -988,24 +1292,22 @@ void Grounder::checkStaticVariables(GroundedAction &a, vector<bool> &staticVar)
          staticVar[a.endNumEff[i].varIndex] = false;        
 }
 
-// Stores in the vector the initial values for this variable. Can be multiple due to the time-initial literals
-void Grounder::getInitialValues(unsigned int varIndex, vector<Fact*> &initValues) {
+// Stores the initial values of every variable. Can be multiple due to the time-initial literals
+void Grounder::getInitialValues(vector< vector<Fact*> > &initValues) {
      vector<Fact> &init = prepTask->task->init;
-     GroundedVar &var = gTask->variables[varIndex];
-     for (unsigned int i = 0; i < init.size(); i++)
-         if (init[i].function == var.fncIndex) {
-            bool equal = true;
-            for (unsigned int j = 0; j < var.params.size(); j++)
-                if (var.params[j] != init[i].parameters[j]) {
-                   equal = false;
-                   break;
-                }
-            if (equal) initValues.push_back(&init[i]);
-         }
+     GrounderTupleIndex index;
+     initValues.clear();
+     initValues.resize(gTask->variables.size());
+     for (unsigned int i = 0; i < gTask->variables.size(); i++)
+         index.insert(getVariableKey(gTask->variables[i].fncIndex, gTask->variables[i].params), i);
+     for (unsigned int i = 0; i < init.size(); i++) {
+         unsigned int v = index.find(getVariableKey(init[i].function, init[i].parameters));
+         if (v != MAX_UNSIGNED_INT) initValues[v].push_back(&init[i]);
+     }
 }
 
 // Removes the static variables after the grounding process
-void Grounder::removeStaticVariables(vector<bool> &staticVar, vector<unsigned int> &newIndex, vector<VariableValue> &value) {
+void Grounder::removeStaticVariables(vector<bool> &staticVar, vector<unsigned int> &newIndex, vector<VariableValue> &value, bool checkNumeric) {
     groupVariables(staticVar, newIndex);
 #ifdef _GROUNDER_TRACE_ON_
     for (unsigned int i = 0; i < staticVar.size(); i++)
@@ -1013,64 +1315,22 @@ void Grounder::removeStaticVariables(vector<bool> &staticVar, vector<unsigned in
               staticVar[i] << ", " << i << " -> " << newIndex[i] << ", " <<
               (value[i].valueIsNumeric ? value[i].numericValue : value[i].value) << endl;
 #endif
-    unsigned int i = 0;
-    while (i < gTask->actions.size()) {
-        GroundedAction &a = gTask->actions[i];
-        a.index = i;
-        for (unsigned int j = 0; j < a.duration.size(); j++)
-            removeStaticVariables(a.duration[j].exp, staticVar, newIndex, value);
-        bool remove = (a.duration.size() == 1 && a.duration[0].exp.value <= 0 && a.duration[0].exp.type == GE_NUMBER &&  // Delete actions with invalid duration
-            (a.duration[0].comp == CMP_EQ || a.duration[0].comp == CMP_LESS || a.duration[0].comp == CMP_LESS_EQ));
-        if (!remove) remove = removeStaticVariables(a.startCond, staticVar, newIndex, value);
-        if (!remove) remove = removeStaticVariables(a.overCond, staticVar, newIndex, value);
-        if (!remove) remove = removeStaticVariables(a.endCond, staticVar, newIndex, value);
-        if (!remove) remove = removeStaticVariables(a.startEff, staticVar, newIndex, value);
-        if (!remove) remove = removeStaticVariables(a.endEff, staticVar, newIndex, value);
-        if (!remove) remove = removeStaticVariables(a.startNumCond, staticVar, newIndex, value);
-        if (!remove) remove = removeStaticVariables(a.overNumCond, staticVar, newIndex, value);
-        if (!remove) remove = removeStaticVariables(a.endNumCond, staticVar, newIndex, value);
-        if (!remove) remove = removeStaticVariables(a.startNumEff, staticVar, newIndex, value);
-        if (!remove) remove = removeStaticVariables(a.endNumEff, staticVar, newIndex, value);
-        if (!remove) remove = removeStaticVariables(a.preferences, staticVar, newIndex, value);
-        if (remove) gTask->actions.erase(gTask->actions.begin() + i);
-        else i++;
-    }
-    i = 0;
-    while (i < gTask->goals.size()) {
-        GroundedAction &a = gTask->goals[i];
-        a.index = i;
-        for (unsigned int j = 0; j < a.duration.size(); j++)
-            removeStaticVariables(a.duration[j].exp, staticVar, newIndex, value);
-        bool remove = (a.duration.size() == 1 && a.duration[0].exp.value <= 0 && a.duration[0].exp.type == GE_NUMBER &&  // Delete actions with invalid duration
-            (a.duration[0].comp == CMP_EQ || a.duration[0].comp == CMP_LESS || a.duration[0].comp == CMP_LESS_EQ));
-        if (!remove) remove = removeStaticVariables(a.startCond, staticVar, newIndex, value);
-        if (!remove) remove = removeStaticVariables(a.overCond, staticVar, newIndex, value);
-        if (!remove) remove = removeStaticVariables(a.endCond, staticVar, newIndex, value);
-        if (!remove) remove = removeStaticVariables(a.startEff, staticVar, newIndex, value);
-        if (!remove) remove = removeStaticVariables(a.endEff, staticVar, newIndex, value);
-        if (!remove) remove = removeStaticVariables(a.startNumCond, staticVar, newIndex, value);
-        if (!remove) remove = removeStaticVariables(a.overNumCond, staticVar, newIndex, value);
-        if (!remove) remove = removeStaticVariables(a.endNumCond, staticVar, newIndex, value);
-        if (!remove) remove = removeStaticVariables(a.startNumEff, staticVar, newIndex, value);
-        if (!remove) remove = removeStaticVariables(a.endNumEff, staticVar, newIndex, value);
-        if (!remove) remove = removeStaticVariables(a.preferences, staticVar, newIndex, value);
-        if (remove) gTask->goals.erase(gTask->goals.begin() + i);
-        else i++;
-    }
+    removeStaticVariables(gTask->actions, staticVar, newIndex, value, checkNumeric);
+    removeStaticVariables(gTask->goals, staticVar, newIndex, value, false);
     unsigned int numNonStaticVars = 0;
     for (unsigned int i = 0; i < staticVar.size(); i++)
         if (!staticVar[i]) numNonStaticVars++;
-    vector<GroundedVar> oldVariables = gTask->variables;
-    vector< vector<unsigned int> > oldReachedValues = gTask->reachedValues;
+    vector<GroundedVar> oldVariables = std::move(gTask->variables);
+    vector< vector<unsigned int> > oldReachedValues = std::move(gTask->reachedValues);
     gTask->variables.resize(numNonStaticVars);
     gTask->reachedValues.resize(numNonStaticVars);
     for (unsigned int i = 0; i < staticVar.size(); i++) {
         if (!staticVar[i]) {
-            gTask->variables[newIndex[i]] = oldVariables[i];
-            gTask->reachedValues[newIndex[i]] = oldReachedValues[i];
+            gTask->variables[newIndex[i]] = std::move(oldVariables[i]);
+            gTask->reachedValues[newIndex[i]] = std::move(oldReachedValues[i]);
         }
     }
-    i = 0;
+    unsigned int i = 0;
     while (i < gTask->constraints.size()) {
     	if (removeStaticVariables(gTask->constraints[i], staticVar, newIndex, value))
     		gTask->constraints.erase(gTask->constraints.begin() + i);
@@ -1080,6 +1340,60 @@ void Grounder::removeStaticVariables(vector<bool> &staticVar, vector<unsigned in
     	removeStaticVariables(gTask->metric, staticVar, newIndex, value);
 }
 
+// Replaces the static variables in a set of actions in a single sweep, in parallel, and removes the actions
+// that become inapplicable. The numeric conditions that can be evaluated are also checked if checkNumeric is true
+void Grounder::removeStaticVariables(vector<GroundedAction> &actions, vector<bool> &staticVar, vector<unsigned int> &newIndex, vector<VariableValue> &value, bool checkNumeric) {
+    unsigned int numActions = actions.size();
+    vector<char> remove(numActions, false);
+    unsigned int numThreads = getNumThreads(numActions);
+    vector<thread> threads;
+    for (unsigned int t = 1; t < numThreads; t++)
+        threads.emplace_back(&Grounder::substituteStaticVariables, this, &actions, &remove, checkNumeric,
+            &staticVar, &newIndex, &value, t, numThreads);
+    substituteStaticVariables(&actions, &remove, checkNumeric, &staticVar, &newIndex, &value, 0, numThreads);
+    for (unsigned int t = 0; t < threads.size(); t++)
+        threads[t].join();
+    unsigned int i = 0;
+    for (unsigned int j = 0; j < numActions; j++) {    // Stable compaction of the remaining actions
+        if (remove[j]) continue;
+        if (i != j) actions[i] = std::move(actions[j]);
+        actions[i].index = i;
+        i++;
+    }
+    actions.erase(actions.begin() + i, actions.end());
+}
+
+// Thread worker: replaces the static variables in the actions first, first + step, first + 2*step, ...
+void Grounder::substituteStaticVariables(vector<GroundedAction>* actions, vector<char>* remove, bool checkNumeric,
+        vector<bool>* staticVar, vector<unsigned int>* newIndex, vector<VariableValue>* value, unsigned int first, unsigned int step) {
+    for (unsigned int i = first; i < actions->size(); i += step) {
+        GroundedAction &a = (*actions)[i];
+        bool removeAction = removeStaticVariables(a, *staticVar, *newIndex, *value);
+        if (!removeAction && checkNumeric) removeAction = !checkNumericConditions(a);
+        (*remove)[i] = removeAction;
+    }
+}
+
+// Replaces the static variables in an action. Returns true if the action must be removed
+bool Grounder::removeStaticVariables(GroundedAction &a, vector<bool> &staticVar, vector<unsigned int> &newIndex, vector<VariableValue> &value) {
+    for (unsigned int j = 0; j < a.duration.size(); j++)
+        removeStaticVariables(a.duration[j].exp, staticVar, newIndex, value);
+    bool remove = (a.duration.size() == 1 && a.duration[0].exp.value <= 0 && a.duration[0].exp.type == GE_NUMBER &&  // Delete actions with invalid duration
+        (a.duration[0].comp == CMP_EQ || a.duration[0].comp == CMP_LESS || a.duration[0].comp == CMP_LESS_EQ));
+    if (!remove) remove = removeStaticVariables(a.startCond, staticVar, newIndex, value);
+    if (!remove) remove = removeStaticVariables(a.overCond, staticVar, newIndex, value);
+    if (!remove) remove = removeStaticVariables(a.endCond, staticVar, newIndex, value);
+    if (!remove) remove = removeStaticVariables(a.startEff, staticVar, newIndex, value);
+    if (!remove) remove = removeStaticVariables(a.endEff, staticVar, newIndex, value);
+    if (!remove) remove = removeStaticVariables(a.startNumCond, staticVar, newIndex, value);
+    if (!remove) remove = removeStaticVariables(a.overNumCond, staticVar, newIndex, value);
+    if (!remove) remove = removeStaticVariables(a.endNumCond, staticVar, newIndex, value);
+    if (!remove) remove = removeStaticVariables(a.startNumEff, staticVar, newIndex, value);
+    if (!remove) remove = removeStaticVariables(a.endNumEff, staticVar, newIndex, value);
+    if (!remove) remove = removeStaticVariables(a.preferences, staticVar, newIndex, value);
+    return remove;
+}
+
 // Removes the static variables in the metric
 void Grounder::removeStaticVariables(GroundedMetric &m, std::vector<bool> &staticVar, std::vector<unsigned int> &newIndex, std::vector<VariableValue> &value) {
 	switch (m.type) {
@@ -1375,9 +1689,10 @@ float Grounder::computeExpressionValue(PartiallyGroundedNumericExpression &e) {
 
 // Computes the initial-state values of the variables
 void Grounder::computeInitialVariableValues() {
+    vector< vector<Fact*> > varInitValues;
+    getInitialValues(varInitValues);
     for (unsigned int i = 0; i < gTask->variables.size(); i++) {
-        vector<Fact*> initValues;      // Initial values for this variable. Can be multiple due to the time-initial literals (TIL)
-        getInitialValues(i, initValues);
+        vector<Fact*> &initValues = varInitValues[i];  // Can be multiple due to the time-initial literals (TIL)
         GroundedVar &v = gTask->variables[i];
         for (unsigned int j = 0; j < initValues.size(); j++) {
             Fact *f = initValues[j];
@@ -1828,7 +2143,9 @@ GroundedMetric Grounder::groundMetric(Metric* m) {
 								gm.terms.push_back(groundMetric(&(m->terms[i])));
 							break;
 	case MT_IS_VIOLATED:	gm.index = preferenceIndex[m->preferenceName];	break;
-	case MT_FLUENT:			gm.index = variableIndex[getVariableName(m->function, m->parameters)];	break;
+	case MT_FLUENT:			gm.index = variableIndex.find(getVariableKey(m->function, m->parameters));
+							if (gm.index == MAX_UNSIGNED_INT) gm.index = 0;		// Unknown fluent
+							break;
 	case MT_TOTAL_TIME:;
 	}
 	return gm;
@@ -1837,33 +2154,33 @@ GroundedMetric Grounder::groundMetric(Metric* m) {
 // Checks if there are numeric conditions that can already be evaluated
 void Grounder::checkNumericConditions() {
 	unsigned int i = 0;
-	while (i < gTask->actions.size()) {
-		GroundedAction* a = &(gTask->actions[i]);
-		bool removeAction = false;
-		unsigned int j = 0;
-		while (j < a->startNumCond.size()) {
-			int checking = checkNumericCondition(&(a->startNumCond[j]));
-			if (checking == -1) removeAction = true;									// Condition can be evaluated and does not hold
-			else if (checking == 1) a->startNumCond.erase(a->startNumCond.begin() + j);	// Condition can be evaluated and holds
-			else j++;
-		}
-		j = 0;
-		while (j < a->overNumCond.size()) {
-			int checking = checkNumericCondition(&(a->overNumCond[j]));
-			if (checking == -1) removeAction = true;									// Condition can be evaluated and does not hold
-			else if (checking == 1) a->overNumCond.erase(a->overNumCond.begin() + j);	// Condition can be evaluated and holds
-			else j++;
-		}
-		j = 0;
-		while (j < a->endNumCond.size()) {
-			int checking = checkNumericCondition(&(a->endNumCond[j]));
-			if (checking == -1) removeAction = true;									// Condition can be evaluated and does not hold
-			else if (checking == 1) a->endNumCond.erase(a->endNumCond.begin() + j);	// Condition can be evaluated and holds
-			else j++;
-		}
-		if (removeAction) gTask->actions.erase(gTask->actions.begin() + i);
-		else a->index = i++;
+	for (unsigned int j = 0; j < gTask->actions.size(); j++) {
+		if (!checkNumericConditions(gTask->actions[j])) continue;
+		if (i != j) gTask->actions[i] = std::move(gTask->actions[j]);
+		gTask->actions[i].index = i;
+		i++;
 	}
+	gTask->actions.erase(gTask->actions.begin() + i, gTask->actions.end());
+}
+
+// Checks the numeric conditions of an action that can be evaluated. Returns false if one of them does not hold
+bool Grounder::checkNumericConditions(GroundedAction &a) {
+	return checkNumericConditions(a.startNumCond) && checkNumericConditions(a.overNumCond) &&
+		checkNumericConditions(a.endNumCond);
+}
+
+// Removes the numeric conditions that can be evaluated and hold. Returns false if one of them does not hold
+bool Grounder::checkNumericConditions(vector<GroundedNumericCondition> &cond) {
+	unsigned int i = 0;
+	for (unsigned int j = 0; j < cond.size(); j++) {
+		int checking = checkNumericCondition(&(cond[j]));
+		if (checking == -1) return false;			// Condition can be evaluated and does not hold
+		if (checking == 1) continue;				// Condition can be evaluated and holds
+		if (i != j) cond[i] = std::move(cond[j]);
+		i++;
+	}
+	cond.erase(cond.begin() + i, cond.end());
+	return true;
 }
 
 // Checks if a numeric condition can be evaluated. Returns 0 if it is not possible.
@@ -1877,3 +2194,183 @@ int Grounder::checkNumericCondition(GroundedNumericCondition* c) {
 	if (numericComparisonHolds(*c)) return 1;
 	else return -1;
 }
+
+// Removes the actions that cannot contribute to the goals, the metric, the preferences or the constraints, and
+// the variables that are no longer used. The relevant values are computed backwards from those elements: an action is
+// relevant if it produces a relevant value, and then all the values it requires are relevant. Relevant actions keep
+// all their effects
+void Grounder::removeIrrelevantData() {
+	unsigned int numVars = gTask->variables.size(), numActions = gTask->actions.size();
+	relevantVar.assign(numVars, false);
+	allValuesRelevant.assign(numVars, false);
+	relevantValue.assign(numVars, vector<bool>());
+	variablesOfFunction.assign(gTask->task->functions.size(), vector<unsigned int>());
+	for (unsigned int v = 0; v < numVars; v++)
+		if (gTask->variables[v].fncIndex < variablesOfFunction.size())
+			variablesOfFunction[gTask->variables[v].fncIndex].push_back(v);
+	vector< vector<unsigned int> > producers(numVars);		// Actions that modify each variable
+	for (unsigned int i = 0; i < numActions; i++) {
+		GroundedAction &a = gTask->actions[i];
+		for (unsigned int j = 0; j < a.startEff.size(); j++) producers[a.startEff[j].varIndex].push_back(i);
+		for (unsigned int j = 0; j < a.endEff.size(); j++) producers[a.endEff[j].varIndex].push_back(i);
+		for (unsigned int j = 0; j < a.startNumEff.size(); j++) producers[a.startNumEff[j].varIndex].push_back(i);
+		for (unsigned int j = 0; j < a.endNumEff.size(); j++) producers[a.endNumEff[j].varIndex].push_back(i);
+	}
+	for (unsigned int i = 0; i < gTask->goals.size(); i++)
+		markRelevant(gTask->goals[i]);
+	for (unsigned int i = 0; i < gTask->constraints.size(); i++)
+		markRelevant(gTask->constraints[i]);
+	if (gTask->metricType != 'X')
+		markRelevant(gTask->metric);
+	vector<bool> relevantAction(numActions, false);
+	while (!pendingVars.empty()) {
+		unsigned int v = pendingVars.back();
+		pendingVars.pop_back();
+		for (unsigned int i = 0; i < producers[v].size(); i++) {
+			unsigned int a = producers[v][i];
+			if (!relevantAction[a] && hasRelevantEffect(gTask->actions[a])) {
+				relevantAction[a] = true;
+				markRelevant(gTask->actions[a]);
+			}
+		}
+	}
+	vector<bool> irrelevantVar(numVars);
+	for (unsigned int v = 0; v < numVars; v++)
+		irrelevantVar[v] = !relevantVar[v];
+	unsigned int i = 0;
+	for (unsigned int j = 0; j < numActions; j++) {
+		if (!relevantAction[j]) continue;
+		if (i != j) gTask->actions[i] = std::move(gTask->actions[j]);
+		gTask->actions[i].index = i;
+		keepModifiedVariables(gTask->actions[i], irrelevantVar);
+		i++;
+	}
+	numIrrelevantActions = numActions - i;
+	gTask->actions.resize(i);
+	vector<unsigned int> newIndex(numVars);
+	vector<VariableValue> value(numVars);
+	unsigned int index = 0;
+	for (unsigned int v = 0; v < numVars; v++)
+		newIndex[v] = irrelevantVar[v] ? MAX_UNSIGNED_INT : index++;
+	numIrrelevantVariables = numVars - index;
+	if (numIrrelevantVariables > 0) {						// Irrelevant variables no longer appear in the task
+		removeStaticVariables(irrelevantVar, newIndex, value, false);
+		for (unsigned int v = 0; v < gTask->variables.size(); v++)
+			gTask->variables[v].index = v;
+	}
+	relevantVar.clear();
+	allValuesRelevant.clear();
+	relevantValue.clear();
+	variablesOfFunction.clear();
+}
+
+// Marks a value of a variable as relevant
+void Grounder::markRelevant(unsigned int varIndex, unsigned int valueIndex) {
+	if (allValuesRelevant[varIndex]) return;
+	vector<bool> &values = relevantValue[varIndex];
+	if (valueIndex >= values.size()) values.resize(valueIndex + 1, false);
+	if (values[valueIndex]) return;
+	values[valueIndex] = true;
+	relevantVar[varIndex] = true;
+	pendingVars.push_back(varIndex);
+}
+
+// Marks all the values of a variable as relevant
+void Grounder::markRelevant(unsigned int varIndex) {
+	if (allValuesRelevant[varIndex]) return;
+	allValuesRelevant[varIndex] = true;
+	relevantVar[varIndex] = true;
+	pendingVars.push_back(varIndex);
+}
+
+// Marks as relevant the values required by an action
+void Grounder::markRelevant(GroundedAction &a) {
+	for (unsigned int i = 0; i < a.startCond.size(); i++) markRelevant(a.startCond[i].varIndex, a.startCond[i].valueIndex);
+	for (unsigned int i = 0; i < a.overCond.size(); i++) markRelevant(a.overCond[i].varIndex, a.overCond[i].valueIndex);
+	for (unsigned int i = 0; i < a.endCond.size(); i++) markRelevant(a.endCond[i].varIndex, a.endCond[i].valueIndex);
+	for (unsigned int i = 0; i < a.duration.size(); i++) markRelevant(a.duration[i].exp);
+	for (unsigned int i = 0; i < a.startNumCond.size(); i++)
+		for (unsigned int j = 0; j < a.startNumCond[i].terms.size(); j++) markRelevant(a.startNumCond[i].terms[j]);
+	for (unsigned int i = 0; i < a.overNumCond.size(); i++)
+		for (unsigned int j = 0; j < a.overNumCond[i].terms.size(); j++) markRelevant(a.overNumCond[i].terms[j]);
+	for (unsigned int i = 0; i < a.endNumCond.size(); i++)
+		for (unsigned int j = 0; j < a.endNumCond[i].terms.size(); j++) markRelevant(a.endNumCond[i].terms[j]);
+	for (unsigned int i = 0; i < a.startNumEff.size(); i++) markRelevant(a.startNumEff[i].exp);
+	for (unsigned int i = 0; i < a.endNumEff.size(); i++) markRelevant(a.endNumEff[i].exp);
+	for (unsigned int i = 0; i < a.preferences.size(); i++) markRelevant(a.preferences[i].preference);
+}
+
+// Marks as relevant the variables in a numeric expression
+void Grounder::markRelevant(GroundedNumericExpression &e) {
+	if (e.type == GE_VAR) markRelevant(e.index);
+	for (unsigned int i = 0; i < e.terms.size(); i++)
+		markRelevant(e.terms[i]);
+}
+
+// Marks as relevant the variables in a partially grounded numeric expression
+void Grounder::markRelevant(PartiallyGroundedNumericExpression &e) {
+	if (e.type == PGE_VAR) markRelevant(e.index);
+	else if (e.type == PGE_UNGROUNDED_VAR) markRelevantFunction(e.index);
+	for (unsigned int i = 0; i < e.terms.size(); i++)
+		markRelevant(e.terms[i]);
+}
+
+// Marks as relevant the variables in a goal description. All their values are considered relevant
+void Grounder::markRelevant(GroundedGoalDescription &g) {
+	if (g.type == GG_FLUENT) markRelevant(g.index);
+	else if (g.type == GG_UNGROUNDED_FLUENT) markRelevantFunction(g.index);
+	for (unsigned int i = 0; i < g.terms.size(); i++)
+		markRelevant(g.terms[i]);
+	for (unsigned int i = 0; i < g.exp.size(); i++)
+		markRelevant(g.exp[i]);
+}
+
+// Marks as relevant the variables in a constraint
+void Grounder::markRelevant(GroundedConstraint &c) {
+	for (unsigned int i = 0; i < c.terms.size(); i++)
+		markRelevant(c.terms[i]);
+	for (unsigned int i = 0; i < c.goal.size(); i++)
+		markRelevant(c.goal[i]);
+}
+
+// Marks as relevant the variables in the metric
+void Grounder::markRelevant(GroundedMetric &m) {
+	if (m.type == MT_FLUENT) markRelevant(m.index);
+	for (unsigned int i = 0; i < m.terms.size(); i++)
+		markRelevant(m.terms[i]);
+}
+
+// Marks as relevant all the variables of a function. The list of variables is emptied, as they only need to be marked once
+void Grounder::markRelevantFunction(unsigned int fncIndex) {
+	if (fncIndex >= variablesOfFunction.size()) return;
+	vector<unsigned int> vars;
+	vars.swap(variablesOfFunction[fncIndex]);
+	for (unsigned int i = 0; i < vars.size(); i++)
+		markRelevant(vars[i]);
+}
+
+// Checks if an action produces a relevant value or modifies a relevant numeric variable
+bool Grounder::hasRelevantEffect(GroundedAction &a) {
+	for (unsigned int k = 0; k < 2; k++) {
+		vector<GroundedCondition> &eff = k == 0 ? a.startEff : a.endEff;
+		for (unsigned int i = 0; i < eff.size(); i++) {
+			unsigned int v = eff[i].varIndex, value = eff[i].valueIndex;
+			if (allValuesRelevant[v] || (value < relevantValue[v].size() && relevantValue[v][value]))
+				return true;
+		}
+		vector<GroundedNumericEffect> &numEff = k == 0 ? a.startNumEff : a.endNumEff;
+		for (unsigned int i = 0; i < numEff.size(); i++)
+			if (relevantVar[numEff[i].varIndex])
+				return true;
+	}
+	return false;
+}
+
+// Keeps the variables modified by a relevant action, even if they have no relevant values. Its effects on them
+// are needed to detect the interferences with other actions that modify them at the same time
+void Grounder::keepModifiedVariables(GroundedAction &a, vector<bool> &irrelevantVar) {
+	for (unsigned int i = 0; i < a.startEff.size(); i++) irrelevantVar[a.startEff[i].varIndex] = false;
+	for (unsigned int i = 0; i < a.endEff.size(); i++) irrelevantVar[a.endEff[i].varIndex] = false;
+	for (unsigned int i = 0; i < a.startNumEff.size(); i++) irrelevantVar[a.startNumEff[i].varIndex] = false;
+	for (unsigned int i = 0; i < a.endNumEff.size(); i++) irrelevantVar[a.endNumEff[i].varIndex] = false;
+}
@@ -18,12 +18,19 @@ public:
 class GrounderOperator {
 public:
     Operator *op;
+    unsigned int index;
+    unsigned int nameIndex;     // Operators with the same name share this index
     unsigned int numParams;
     std::vector<unsigned int> *paramValues;
     std::vector<unsigned int> *compatibleObjectsWithParam;
+    std::vector<uint64_t> *compatibleObjectBits;    // Bit set of the objects compatible with each parameter
     unsigned int newValueIndex;
     std::vector<GrounderAssignment> preconditions;
     void initialize(Operator &o);
+    void initialize(GrounderOperator &o);
+    inline bool isCompatible(unsigned int paramIndex, unsigned int objIndex) {
+        return (compatibleObjectBits[paramIndex][objIndex >> 6] >> (objIndex & 63)) & 1;
+    }
     ~GrounderOperator();
 };
 
@@ -35,6 +42,32 @@ public:
     ProgrammedValue(unsigned int index, unsigned int varIndex, unsigned int valueIndex);
 };
 
+class GrounderTupleIndex {     // Hash table from tuples of unsigned integers to indexes. Keys are stored in a single array
+private:
+    std::vector<unsigned int> tuples;                           // Stored keys, one after another, each one preceded by its length
+    std::vector<std::pair<unsigned int, unsigned int>> slots;   // (position of the key in tuples, value). MAX_UNSIGNED_INT position if empty
+    unsigned int count;
+
+    static uint64_t hash(const std::vector<unsigned int> &key);
+    unsigned int findSlot(const std::vector<unsigned int> &key);
+    void grow();
+
+public:
+    GrounderTupleIndex() : count(0) {}
+    unsigned int find(const std::vector<unsigned int> &key);
+    void insert(const std::vector<unsigned int> &key, unsigned int value);
+    void clear();
+};
+
+class GrounderStaticFunction {  // Values of a static numeric function, indexed by the tuple of parameters
+public:
+    bool isStatic;
+    bool dense;
+    std::vector<float> values;      // Dense: one value for each tuple of objects (NaN if undefined). Sparse: defined values
+    GrounderTupleIndex index;       // Sparse: position in values of each tuple of parameters
+    GrounderStaticFunction() : isStatic(false), dense(false) {}
+};
+
 class VariableValue {
 public:
     bool valueIsNumeric;
@@ -46,39 +79,60 @@ class Grounder {
 private:
     PreprocessedTask *prepTask;
     GroundedTask* gTask;
-    bool **typesMatrix;
+    std::vector<std::vector<uint64_t>> objectsOfType;  // Bit set of the objects of each type, including its subtypes
     unsigned int numOps;
     GrounderOperator *ops;
+    std::vector<GrounderOperator*> threadOps;  // Copy of the operators for each matching thread (the first one is ops)
     std::vector<GrounderOperator*> *opRequireFunction;
-    std::unordered_map<std::string,unsigned int> variableIndex;
+    GrounderTupleIndex variableIndex;       // Variables by (function, parameters)
+    std::vector<GrounderStaticFunction> staticFunctions;   // Numeric functions that no action modifies
     std::unordered_map<std::string,unsigned int> preferenceIndex;
     std::vector<ProgrammedValue> *newValues;
     std::vector<ProgrammedValue> *auxValues;
     std::vector<ProgrammedValue> *valuesByFunction;
-	std::unordered_map<std::string, unsigned int> groundedActions;
+    std::unordered_map<uint64_t, std::vector<unsigned int>> valuesByArgument;  // Positions in valuesByFunction of the values with an object in an argument
+    std::vector<unsigned int> noValues;
+    GrounderTupleIndex groundedActions;     // Actions by (operator name, parameters)
+    std::vector<unsigned int> key;          // Buffer to build the keys of the indexes
 	unsigned int numValues;
     unsigned int startNewValues;
     unsigned int currentLevel;
+    unsigned int numIrrelevantActions;
+    unsigned int numIrrelevantVariables;
+    std::vector<bool> relevantVar;                      // Variables with some relevant value
+    std::vector<bool> allValuesRelevant;                // Variables whose values are all relevant
+    std::vector< std::vector<bool> > relevantValue;
+    std::vector<unsigned int> pendingVars;              // Variables with new relevant values whose producers must be checked
+    std::vector< std::vector<unsigned int> > variablesOfFunction;  // Variables of each function not marked as relevant yet
     
-    std::string getVariableName(unsigned int function, const std::vector<unsigned int> &parameters);
-    std::string getVariableName(const Literal &l, const std::vector<unsigned int> &opParameters);
+    const std::vector<unsigned int>& getVariableKey(unsigned int function, const std::vector<unsigned int> &parameters);
+    const std::vector<unsigned int>& getVariableKey(const Literal &l, const std::vector<unsigned int> &opParameters);
     void initTypesMatrix();
+    void initStaticFunctions();
+    float getStaticValue(const Literal &l, const std::vector<unsigned int> &opParameters);
     void clearMemory();
-    void addTypeToMatrix(unsigned int typeIndex, unsigned int subtypeIndex);
+    void addTypeToMatrix(bool **typesMatrix, unsigned int typeIndex, unsigned int subtypeIndex);
     void initOperators();
     void addOpToRequireFunction(GrounderOperator *op, unsigned int f);
     void initInitialState();
     void createVariable(const Fact &f);
     unsigned int getVariableIndex(const Fact &f);
     unsigned int getVariableIndex(const Literal &l, const std::vector<unsigned int> &opParameters);
-    void groundRemainingParameters(GrounderOperator &op);
+    void groundRemainingParameters(GrounderOperator &op, std::vector<unsigned int>* bindings);
     void groundAction(GrounderOperator &op);
-    bool objectIsCompatible(unsigned int objIndex, std::vector<unsigned int> &types);
-    void match(ProgrammedValue &pv);
+    inline static uint64_t getArgumentKey(unsigned int function, unsigned int argument, unsigned int object) {
+        return ((uint64_t) function << 40) + ((uint64_t) argument << 32) + object;
+    }
+    void addReachedValue(ProgrammedValue &pv);
+    void matchNewValues();
+    void matchValues(std::vector<std::vector<unsigned int>>* bindings, unsigned int first, unsigned int step);
+    void match(ProgrammedValue &pv, GrounderOperator* opSet, std::vector<unsigned int>* bindings);
     void swapLevels();
     int matches(GrounderOperator *op, unsigned int varIndex, unsigned int valueIndex, int startPrec);
     void stackParameters(GrounderOperator *op, int precIndex, unsigned int varIndex, unsigned int valueIndex);
-    void completeMatch(GrounderOperator *op, unsigned int precIndex);
+    void completeMatch(GrounderOperator *op, unsigned int precIndex, std::vector<unsigned int>* bindings);
+    const std::vector<unsigned int>* getCandidateValues(GrounderOperator *op, GrounderAssignment &p);
+    void matchValue(GrounderOperator *op, unsigned int precIndex, ProgrammedValue &pv, std::vector<unsigned int>* bindings);
     void unstackParameters(GrounderOperator *op, int precIndex);
     bool precMatches(GrounderOperator *op, GrounderAssignment &p, unsigned int varIndex, unsigned int valueIndex);
     bool checkEqualityConditions(GrounderOperator &op, GroundedAction &a);
@@ -101,8 +155,12 @@ private:
     PartiallyGroundedNumericExpression partiallyGroundNumericExpression(NumericExpression &exp, std::vector<unsigned int> &parameters);
     void removeStaticVariables();
     void checkStaticVariables(GroundedAction &a, std::vector<bool> &staticVar);
-    void getInitialValues(unsigned int varIndex, std::vector<Fact*> &initValues);
-    void removeStaticVariables(std::vector<bool> &staticVar, std::vector<unsigned int> &newIndex, std::vector<VariableValue> &value);
+    void getInitialValues(std::vector< std::vector<Fact*> > &initValues);
+    void removeStaticVariables(std::vector<bool> &staticVar, std::vector<unsigned int> &newIndex, std::vector<VariableValue> &value, bool checkNumeric);
+    void removeStaticVariables(std::vector<GroundedAction> &actions, std::vector<bool> &staticVar, std::vector<unsigned int> &newIndex, std::vector<VariableValue> &value, bool checkNumeric);
+    void substituteStaticVariables(std::vector<GroundedAction>* actions, std::vector<char>* remove, bool checkNumeric,
+        std::vector<bool>* staticVar, std::vector<unsigned int>* newIndex, std::vector<VariableValue>* value, unsigned int first, unsigned int step);
+    bool removeStaticVariables(GroundedAction &a, std::vector<bool> &staticVar, std::vector<unsigned int> &newIndex, std::vector<VariableValue> &value);
     void groupVariables(std::vector<bool> &staticVar, std::vector<unsigned int> &newIndex);
     bool removeStaticVariables(GroundedNumericExpression &e, std::vector<bool> &staticVar, std::vector<unsigned int> &newIndex, std::vector<VariableValue> &value);
     float computeExpressionValue(GroundedNumericExpression &e);
@@ -130,10 +188,27 @@ private:
     GroundedMetric groundMetric(Metric* m);
 	void removeStaticVariables(GroundedMetric &m, std::vector<bool> &staticVar, std::vector<unsigned int> &newIndex, std::vector<VariableValue> &value);
 	void checkNumericConditions();
+	bool checkNumericConditions(GroundedAction &a);
+	bool checkNumericConditions(std::vector<GroundedNumericCondition> &cond);
 	int checkNumericCondition(GroundedNumericCondition* c);
+	void removeIrrelevantData();
+	void markRelevant(unsigned int varIndex, unsigned int valueIndex);
+	void markRelevant(unsigned int varIndex);
+	void markRelevant(GroundedAction &a);
+	void markRelevant(GroundedNumericExpression &e);
+	void markRelevant(PartiallyGroundedNumericExpression &e);
+	void markRelevant(GroundedGoalDescription &g);
+	void markRelevant(GroundedConstraint &c);
+	void markRelevant(GroundedMetric &m);
+	void markRelevantFunction(unsigned int fncIndex);
+	bool hasRelevantEffect(GroundedAction &a);
+	void keepModifiedVariables(GroundedAction &a, std::vector<bool> &irrelevantVar);
 
 public:
-    GroundedTask* groundTask(PreprocessedTask *prepTask, bool keepStaticData);
+    GroundedTask* groundTask(PreprocessedTask *prepTask, bool keepStaticData, bool pruneIrrelevant);
+    double estimateNumActions(PreprocessedTask *prepTask);
+    inline unsigned int getNumIrrelevantActions() { return numIrrelevantActions; }
+    inline unsigned int getNumIrrelevantVariables() { return numIrrelevantVariables; }
 };
 
 #endif
@@ -109,7 +109,7 @@ std::string DTG::toString() {
 }
 
 void DTG::calculateTransitionsToValue(TValue toValue, CausalGraph* cg) {
-	std::vector<SASAction*>& prod = task->producers[var][toValue];
+	SASActionList prod = task->getProducers(var, toValue);
 	for (unsigned int i = 0; i < prod.size(); i++) {
 		SASAction* a = prod[i];
 		TValue fromValue = getFromValue(a);
@@ -25,7 +25,7 @@ void CostRPG::build(SASTask* task, TState* state, float makespan) {
 	float auxLevel, effLevel;
 	while (qPNormal.size() > 0) {
 		FluentLevel* fl = (FluentLevel*) qPNormal.poll();
-		std::vector<SASAction*> &req = task->requirers[fl->variable][fl->value];
+		SASActionList req = task->getRequirers(fl->variable, fl->value);
 		//cout << "EXTR.: " << fl->toString(task) << ", " << req.size() << " requirers" << endl;
 		for (unsigned int i = 0; i < req.size(); i++) {
 			SASAction* a = req[i];
@@ -76,7 +76,7 @@ void RPG::expand() {
 #ifdef DEBUG_RPG_ON
 			cout << "(" << task->variables[var].name << "," << task->values[value].name << ")" << endl;
 #endif
-			vector<SASAction*> &actions = task->requirers[var][value];
+			SASActionList actions = task->getRequirers(var, value);
 #ifdef DEBUG_RPG_ON
 			cout << actions.size() << " actions" << endl;
 #endif
@@ -114,29 +114,20 @@ void RPG::expand() {
 }
 
 bool RPG::isExecutable(SASAction* a) {
-	for (unsigned int i = 0; i < a->startCond.size(); i++) {
-		if (literalLevels[a->startCond[i].var][a->startCond[i].value] == MAX_INT32)
+	SASActionTable* table = &(task->actionTable);
+	unsigned int last = table->end(a->tableRow, forceAtEndConditions ? SASActionTable::END_COND : SASActionTable::OVER_COND);
+	for (unsigned int i = table->begin(a->tableRow, SASActionTable::START_COND); i < last; i++) {
+		if (literalLevels[table->facts[i].var][table->facts[i].value] == MAX_INT32)
 			return false;
 	}
-	for (unsigned int i = 0; i < a->overCond.size(); i++) {
-		if (literalLevels[a->overCond[i].var][a->overCond[i].value] == MAX_INT32)
-			return false;
-	}
-	if (forceAtEndConditions) {
-		for (unsigned int i = 0; i < a->endCond.size(); i++) {
-			if (literalLevels[a->endCond[i].var][a->endCond[i].value] == MAX_INT32)
-				return false;
-		}
-	}
 	return true;
 }
 
 void RPG::addEffects(SASAction* a) {
-	for (unsigned int i = 0; i < a->startEff.size(); i++) {
-		addEffect(a->startEff[i].var, a->startEff[i].value);
-	}
-	for (unsigned int i = 0; i < a->endEff.size(); i++) {
-		addEffect(a->endEff[i].var, a->endEff[i].value);
+	SASActionTable* table = &(task->actionTable);
+	unsigned int last = table->end(a->tableRow, SASActionTable::END_EFF);
+	for (unsigned int i = table->begin(a->tableRow, SASActionTable::START_EFF); i < last; i++) {
+		addEffect(table->facts[i].var, table->facts[i].value);
 	}
 }
 
@@ -191,7 +182,7 @@ uint16_t RPG::computeHeuristic(bool mutex, PriorityQueue* openConditions) {
 		if (gLevel == MAX_INT32) return MAX_UINT16;
 		literalLevels[g->var][g->value] = -gLevel;
 		reachedValues.push_back(SASTask::getVariableValueCode(g->var, g->value));
-		vector<SASAction*> &prod = task->producers[g->var][g->value];
+		SASActionList prod = task->getProducers(g->var, g->value);
 		SASAction* bestAction = nullptr;
 		bestCost = MAX_UINT16;
 		for (unsigned int i = 0; i < prod.size(); i++) {
@@ -23,7 +23,7 @@ bool LandmarkRPG::verifyFluent(TVariable v, TValue value, TState* s, SASTask* ta
 			TVariable gv = SASTask::getVariableIndex(lastLevel->at(i));
 			TValue gvalue = SASTask::getValueIndex(lastLevel->at(i));
 			if (gv == v && gvalue == value) continue;
-			std::vector<SASAction*> &aList = task->requirers[gv][gvalue];
+			SASActionList aList = task->getRequirers(gv, gvalue);
 			for (unsigned int j = 0; j < aList.size(); j++) {
 				SASAction* a = aList[j];
 				if (!achievedAction[a->index] && isExecutable(a, v, value)) {
@@ -59,7 +59,7 @@ bool LandmarkRPG::verifyFluents(std::vector<TVariable>* v, std::vector<TValue>*
 				}
 			}
 			if (!inSet) {
-				std::vector<SASAction*> &aList = task->requirers[gv][gvalue];
+				SASActionList aList = task->getRequirers(gv, gvalue);
 				for (unsigned int j = 0; j < aList.size(); j++) {
 					SASAction* a = aList[j];
 					if (!achievedAction[a->index] && isExecutable(a, v, value)) {
@@ -84,7 +84,7 @@ bool LandmarkRPG::verifyActions(std::vector<SASAction*>* actions, TState* s, SAS
 		for (unsigned int i = 0; i < lastLevel->size(); i++) {
 			TVariable gv = SASTask::getVariableIndex(lastLevel->at(i));
 			TValue gvalue = SASTask::getValueIndex(lastLevel->at(i));
-			std::vector<SASAction*> &aList = task->requirers[gv][gvalue];
+			SASActionList aList = task->getRequirers(gv, gvalue);
 			for (unsigned int j = 0; j < aList.size(); j++) {
 				SASAction* a = aList[j];
 				if (!achievedAction[a->index] && isExecutable(a) && allowedAction(a, actions)) {
@@ -148,12 +148,10 @@ bool LandmarkRPG::isExecutable(SASAction* a, std::vector<TVariable>* v, std::vec
 }
 
 bool LandmarkRPG::isExecutable(SASAction* a) {
-	for (unsigned int j = 0; j < a->startCond.size(); j++)
-		if (!fluentAchieved(a->startCond[j].var, a->startCond[j].value)) return false;
-	for (unsigned int j = 0; j < a->overCond.size(); j++)
-		if (!fluentAchieved(a->overCond[j].var, a->overCond[j].value)) return false;
-	for (unsigned int j = 0; j < a->endCond.size(); j++)
-		if (!fluentAchieved(a->endCond[j].var, a->endCond[j].value)) return false;
+	SASActionTable* table = &(task->actionTable);
+	unsigned int last = table->end(a->tableRow, SASActionTable::END_COND);
+	for (unsigned int j = table->begin(a->tableRow, SASActionTable::START_COND); j < last; j++)
+		if (!fluentAchieved(table->facts[j].var, table->facts[j].value)) return false;
 	return true;
 }
 
@@ -689,7 +687,7 @@ void LandmarkTree::postProcessing() {
 void LandmarkTree::getActions(std::vector<SASAction*>* aList, LMFluent* l1, LMFluent* l2) {
 	aList->clear();
 	if (rpg.getFluentByIndex(l1->index) == nullptr || rpg.getFluentByIndex(l2->index) == nullptr) return;
-	std::vector<SASAction*> &producers = task->producers[l2->variable][l2->value];
+	SASActionList producers = task->getProducers(l2->variable, l2->value);
 	for (unsigned int i = 0; i < producers.size(); i++) {
 		SASAction* a = producers[i];
 		bool added = false;
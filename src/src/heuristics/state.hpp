@@ -15,6 +15,10 @@ public:
 	TState(SASTask* task);
 	TState(TState* s);
 	~TState();
+	inline void copyValues(TState* s) {
+		for (unsigned int i = 0; i < numSASVars; i++) state[i] = s->state[i];
+		for (unsigned int i = 0; i < numNumVars; i++) numState[i] = s->numState[i];
+	}
 	inline void setSASValue(TVariable var, TValue value) {
 		state[var] = value;
 	}
@@ -58,15 +62,10 @@ public:
 			break;
 		}
 	}
-	inline bool isExecutable(SASAction* a) {
-		for (unsigned int i = 0; i < a->startCond.size(); i++) {
-			if (!holdsCondition(&(a->startCond[i]))) return false;
-		}
-		for (unsigned int i = 0; i < a->overCond.size(); i++) {
-			if (!holdsCondition(&(a->overCond[i]))) return false;
-		}
-		for (unsigned int i = 0; i < a->endCond.size(); i++) {
-			if (!holdsCondition(&(a->endCond[i]))) return false;
+	inline bool isExecutable(SASAction* a, SASActionTable* table) {
+		unsigned int last = table->end(a->tableRow, SASActionTable::END_COND);
+		for (unsigned int i = table->begin(a->tableRow, SASActionTable::START_COND); i < last; i++) {
+			if (state[table->facts[i].var] != table->facts[i].value) return false;
 		}
 		return true;
 	}
@@ -55,7 +55,7 @@ void TemporalRPG::build(TState* state) {
 	float auxLevel;
 	while (qPNormal.size() > 0) {
 		FluentLevel* fl = (FluentLevel*) qPNormal.poll();
-		std::vector<SASAction*> &req = task->requirers[fl->variable][fl->value];
+		SASActionList req = task->getRequirers(fl->variable, fl->value);
 #ifdef DEBUG_TEMPORALRPG_ON
 		cout << "EXTR.: " << fl->toString(task) << ", " << req.size() << " requirers" << endl;
 #endif
@@ -257,7 +257,7 @@ void TemporalRPG::computeActionLevels(TState* state) {
 	}
 	for (unsigned int i = 0; i < fluentList.size(); i++) {
 		LMFluent &f = fluentList[i];
-		std::vector<SASAction*> &p = task->producers[f.variable][f.value];
+		SASActionList p = task->getProducers(f.variable, f.value);
 		for (unsigned int j = 0; j < p.size(); j++) {
 			SASAction* a = p[j];
 			if (actionLevels[a->index] < f.level && actionLevels[a->index] >= 0) {
@@ -0,0 +1,118 @@
+/********************************************************/
+/* Best-first width search on the lifted task. The      */
+/* actions of the plan are scheduled one after another. */
+/********************************************************/
+
+#include <algorithm>
+#include <functional>
+#include <iomanip>
+#include <queue>
+#include <sstream>
+#include <time.h>
+#include <tuple>
+#include "liftedPlanner.hpp"
+using namespace std;
+
+// Creates the planner
+LiftedPlanner::LiftedPlanner(LiftedTask* task) : successors(task) {
+	this->task = task;
+	expandedNodes = 0;
+	solution = MAX_UNSIGNED_INT;
+}
+
+// Adds a new node to the search space. Returns MAX_UNSIGNED_INT if the state was already reached
+unsigned int LiftedPlanner::addNode(const LiftedState &s, unsigned int parent, unsigned int action, float duration) {
+	uint64_t code = s.hash();
+	auto range = stateIndex.equal_range(code);
+	for (auto it = range.first; it != range.second; ++it)
+		if (states[it->second] == s) return MAX_UNSIGNED_INT;
+	unsigned int index = nodes.size();
+	states.push_back(s);
+	nodes.emplace_back(parent, action, duration);
+	stateIndex.emplace(code, index);
+	return index;
+}
+
+// Computes the novelty of the state: 1 if it has a value not seen before in the states with the same number
+// of unsatisfied goals, 2 otherwise. The values of the state are registered as seen
+unsigned int LiftedPlanner::computeNovelty(const LiftedState &s, unsigned int h) {
+	if (h >= seenValues.size()) seenValues.resize(h + 1);
+	unordered_set<uint64_t> &seen = seenValues[h];
+	unsigned int novelty = 2;
+	for (unsigned int i = 0; i < s.values.size(); i++)
+		if (seen.insert(((uint64_t) s.values[i].first << 32) | s.values[i].second).second) novelty = 1;
+	return novelty;
+}
+
+// Searches for a plan. Returns false if there is no plan or the time limit (in seconds) is exceeded. The nodes
+// are selected by their novelty, breaking ties by the number of unsatisfied goals and then in FIFO order
+bool LiftedPlanner::plan(float timeLimit) {
+	clock_t start = clock();
+	addNode(task->initialState, MAX_UNSIGNED_INT, MAX_UNSIGNED_INT, 0);
+	if (successors.isGoal(states[0])) {
+		solution = 0;
+		return true;
+	}
+	priority_queue< LiftedOpenNode, vector<LiftedOpenNode>, greater<LiftedOpenNode> > open;
+	unsigned int h = successors.countUnsatisfiedGoals(states[0]);
+	open.emplace(computeNovelty(states[0], h), h, 0);
+	vector<unsigned int> candidates;
+	LiftedState next;
+	while (!open.empty()) {
+		unsigned int node = get<2>(open.top());
+		open.pop();
+		if ((++expandedNodes & 255) == 0 && (clock() - start) / (float) CLOCKS_PER_SEC > timeLimit)
+			return false;
+		successors.getCandidateActions(states[node], candidates);
+		for (unsigned int i = 0; i < candidates.size(); i++) {
+			float duration;
+			if (!successors.apply(candidates[i], states[node], next, &duration)) continue;
+			unsigned int child = addNode(next, node, candidates[i], duration);
+			if (child == MAX_UNSIGNED_INT) continue;
+			if (successors.isGoal(states[child])) {
+				solution = child;
+				return true;
+			}
+			h = successors.countUnsatisfiedGoals(states[child]);
+			if (h != MAX_UNSIGNED_INT) open.emplace(computeNovelty(states[child], h), h, child);
+		}
+	}
+	return false;
+}
+
+// Returns the nodes from the initial state to the solution, excluding the initial one
+void LiftedPlanner::getSolutionPath(vector<unsigned int> &path) {
+	path.clear();
+	for (unsigned int n = solution; n != MAX_UNSIGNED_INT && nodes[n].parent != MAX_UNSIGNED_INT; n = nodes[n].parent)
+		path.push_back(n);
+	reverse(path.begin(), path.end());
+}
+
+// Returns the actions of the plan found, in order. Each index refers to the cache of the successor generator
+void LiftedPlanner::getPlan(vector<unsigned int> &actions) {
+	vector<unsigned int> path;
+	getSolutionPath(path);
+	actions.clear();
+	for (unsigned int i = 0; i < path.size(); i++)
+		actions.push_back(nodes[path[i]].action);
+}
+
+// Returns the plan found in PDDL format. Each action starts when the previous one ends
+string LiftedPlanner::planToPDDL() {
+	vector<unsigned int> path;
+	getSolutionPath(path);
+	ostringstream oss;
+	oss << setprecision(3) << fixed;
+	double time = EPSILON, makespan = 0;
+	for (unsigned int i = 0; i < path.size(); i++) {
+		LiftedSearchNode &n = nodes[path[i]];
+		oss << time << ": (" << successors.getActionName(n.action) << ")";
+		if (n.duration > 0) oss << " [" << n.duration << "]";
+		oss << endl;
+		makespan = time + n.duration;
+		time = makespan + EPSILON;
+	}
+	oss << ";Makespan: " << (int)makespan << endl;
+	oss << ";Actions:  " << path.size() << endl;
+	return oss.str();
+}
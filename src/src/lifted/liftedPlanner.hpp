@@ -0,0 +1,52 @@
+#ifndef LIFTED_PLANNER_H
+#define LIFTED_PLANNER_H
+
+/********************************************************/
+/* Best-first width search on the lifted task, guided   */
+/* by the novelty of the states and the number of       */
+/* unsatisfied goals. It is used when the task is too   */
+/* large to be grounded, and returns a sequential plan. */
+/********************************************************/
+
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include "liftedSuccessors.hpp"
+
+typedef std::tuple<unsigned int, unsigned int, unsigned int> LiftedOpenNode;	// (novelty, unsatisfied goals, node)
+
+class LiftedSearchNode {
+public:
+	unsigned int parent;		// MAX_UNSIGNED_INT for the initial state
+	unsigned int action;		// Index of the action in the cache of the successor generator
+	float duration;
+	LiftedSearchNode(unsigned int parent, unsigned int action, float duration) :
+		parent(parent), action(action), duration(duration) {}
+};
+
+class LiftedPlanner {
+private:
+	LiftedTask* task;
+	LiftedSuccessors successors;
+	std::vector<LiftedState> states;			// State of each node
+	std::vector<LiftedSearchNode> nodes;
+	std::unordered_multimap<uint64_t, unsigned int> stateIndex;	// Nodes by state hash code
+	unsigned int expandedNodes;
+	unsigned int solution;
+	std::vector< std::unordered_set<uint64_t> > seenValues;		// Values seen in the states with each number of unsatisfied goals
+
+	unsigned int addNode(const LiftedState &s, unsigned int parent, unsigned int action, float duration);
+	unsigned int computeNovelty(const LiftedState &s, unsigned int h);
+	void getSolutionPath(std::vector<unsigned int> &path);
+
+public:
+	LiftedPlanner(LiftedTask* task);
+	bool plan(float timeLimit);
+	void getPlan(std::vector<unsigned int> &actions);
+	std::string planToPDDL();
+	inline unsigned int getExpandedNodes() { return expandedNodes; }
+	inline unsigned int getNumGroundActions() { return successors.getNumActions(); }
+	inline LiftedSuccessors& getSuccessors() { return successors; }
+};
+
+#endif
@@ -0,0 +1,436 @@
+/********************************************************/
+/* Successor generation of the lifted search. The       */
+/* operators are instantiated by joining their positive */
+/* preconditions with the facts of the state. The       */
+/* remaining conditions are checked on the ground       */
+/* actions, which are stored in a cache.                */
+/********************************************************/
+
+#include <algorithm>
+#include "liftedSuccessors.hpp"
+#include "../grounder/grounder.hpp"
+using namespace std;
+
+// Creates the successor generator
+LiftedSuccessors::LiftedSuccessors(LiftedTask* task) {
+	this->task = task;
+	actionIndex = new GrounderTupleIndex();
+	factsOfFunction.resize(task->task->functions.size());
+	state = nullptr;
+	found = nullptr;
+}
+
+// Disposes the successor generator
+LiftedSuccessors::~LiftedSuccessors() {
+	delete actionIndex;
+}
+
+// Groups the values of the state by function, for the joins
+void LiftedSuccessors::setState(const LiftedState &s) {
+	state = &s;
+	for (unsigned int i = 0; i < factsOfFunction.size(); i++)
+		factsOfFunction[i].clear();
+	for (unsigned int i = 0; i < s.values.size(); i++)
+		factsOfFunction[task->atomFunction[s.values[i].first]].push_back(i);
+}
+
+// Returns the indexes (in the action cache) of the actions whose positive preconditions hold in the state.
+// Apply must be called to check the rest of conditions
+void LiftedSuccessors::getCandidateActions(const LiftedState &s, vector<unsigned int> &candidates) {
+	setState(s);
+	candidates.clear();
+	found = &candidates;
+	for (unsigned int i = 0; i < task->operators.size(); i++)
+		join(task->operators[i], false);
+}
+
+// Instantiates the operator with the facts of the state. The preconditions with fewer candidate facts are joined first
+void LiftedSuccessors::join(LiftedOperator &op, bool isGoal) {
+	bindings.assign(op.op->parameters.size(), MAX_UNSIGNED_INT);
+	vector< pair<unsigned int, unsigned int> > order;
+	for (unsigned int i = 0; i < op.joinPrecs.size(); i++) {
+		unsigned int fnc = op.joinPrecs[i]->variable.fncIndex;
+		unsigned int numFacts = task->staticFunction[fnc] ? task->staticAtomsOfFunction[fnc].size() : factsOfFunction[fnc].size();
+		if (numFacts == 0) return;
+		order.emplace_back(numFacts, i);
+	}
+	sort(order.begin(), order.end());
+	joinOrder.clear();
+	for (unsigned int i = 0; i < order.size(); i++)
+		joinOrder.push_back(order[i].second);
+	join(op, isGoal, 0);
+}
+
+// Joins the precondition in the given step with the facts of the state
+void LiftedSuccessors::join(LiftedOperator &op, bool isGoal, unsigned int step) {
+	if (step == joinOrder.size()) {
+		bindRemainingParameters(op, isGoal, 0);
+		return;
+	}
+	OpFluent* prec = op.joinPrecs[joinOrder[step]];
+	unsigned int fnc = prec->variable.fncIndex;
+	vector<unsigned int> bound;
+	if (task->staticFunction[fnc]) {
+		const vector<unsigned int> &atoms = task->staticAtomsOfFunction[fnc];
+		for (unsigned int i = 0; i < atoms.size(); i++) {
+			if (unify(op, prec, atoms[i], task->staticValue[atoms[i]], bound))
+				join(op, isGoal, step + 1);
+			for (unsigned int j = 0; j < bound.size(); j++)
+				bindings[bound[j]] = MAX_UNSIGNED_INT;
+		}
+	} else {
+		const vector<unsigned int> &facts = factsOfFunction[fnc];
+		for (unsigned int i = 0; i < facts.size(); i++) {
+			const pair<unsigned int, unsigned int> &fact = state->values[facts[i]];
+			if (unify(op, prec, fact.first, fact.second, bound))
+				join(op, isGoal, step + 1);
+			for (unsigned int j = 0; j < bound.size(); j++)
+				bindings[bound[j]] = MAX_UNSIGNED_INT;
+		}
+	}
+}
+
+// Binds the parameters of the operator so the precondition matches the given atom and value. The parameters
+// bound are returned in bound, so they can be released later
+bool LiftedSuccessors::unify(LiftedOperator &op, OpFluent* prec, unsigned int atom, unsigned int value, vector<unsigned int> &bound) {
+	bound.clear();
+	const unsigned int* params = task->getAtomParams(atom);
+	for (unsigned int i = 0; i < prec->variable.params.size(); i++)
+		if (!bindTerm(op, prec->variable.params[i], params[i], bound)) return false;
+	return bindTerm(op, prec->value, value, bound);
+}
+
+// Binds a term of a precondition to an object
+bool LiftedSuccessors::bindTerm(LiftedOperator &op, Term &t, unsigned int obj, vector<unsigned int> &bound) {
+	if (!t.isVariable) return t.index == obj;
+	unsigned int &b = bindings[t.index];
+	if (b != MAX_UNSIGNED_INT) return b == obj;
+	if (!op.isCompatible[t.index][obj]) return false;
+	b = obj;
+	bound.push_back(t.index);
+	return true;
+}
+
+// Gives values to the parameters that do not appear in the joined preconditions
+void LiftedSuccessors::bindRemainingParameters(LiftedOperator &op, bool isGoal, unsigned int param) {
+	if (param == bindings.size()) {
+		unsigned int index = getAction(op, isGoal);
+		if (actions[index].valid) found->push_back(index);
+	} else if (bindings[param] != MAX_UNSIGNED_INT) {
+		bindRemainingParameters(op, isGoal, param + 1);
+	} else {
+		for (unsigned int i = 0; i < op.compatibleObjects[param].size(); i++) {
+			bindings[param] = op.compatibleObjects[param][i];
+			bindRemainingParameters(op, isGoal, param + 1);
+		}
+		bindings[param] = MAX_UNSIGNED_INT;
+	}
+}
+
+// Returns the index of the action for the current bindings, adding it to the cache if it was not created yet
+unsigned int LiftedSuccessors::getAction(LiftedOperator &op, bool isGoal) {
+	key.clear();
+	key.push_back(isGoal ? 1 : 0);
+	key.push_back(op.index);
+	key.insert(key.end(), bindings.begin(), bindings.end());
+	unsigned int index = actionIndex->find(key);
+	if (index == MAX_UNSIGNED_INT) {
+		index = actions.size();
+		actionIndex->insert(key, index);
+		actions.emplace_back();
+		actions.back().isGoal = isGoal;
+		createAction(actions.back(), op);
+	}
+	return index;
+}
+
+// Grounds the conditions and effects of the action
+void LiftedSuccessors::createAction(LiftedAction &a, LiftedOperator &op) {
+	Operator* o = op.op;
+	a.op = op.index;
+	a.parameters = bindings;
+	a.valid = true;
+	for (unsigned int i = 0; i < o->equality.size(); i++) {
+		OpEquality &eq = o->equality[i];
+		if ((getObject(eq.value1, a.parameters) == getObject(eq.value2, a.parameters)) != eq.equal) {
+			a.valid = false;
+			return;
+		}
+	}
+	groundConditions(o->atStart.prec, a, a.startCond);
+	groundConditions(o->overAllPrec, a, a.overCond);
+	groundConditions(o->atEnd.prec, a, a.endCond);
+	if (!groundEffects(o->atStart, a, a.startEff, a.startNumEff) || !groundEffects(o->atEnd, a, a.endEff, a.endNumEff))
+		a.valid = false;
+}
+
+// Grounds a list of conditions
+void LiftedSuccessors::groundConditions(vector<OpFluent> &cond, LiftedAction &a, vector< pair<unsigned int, unsigned int> > &aCond) {
+	for (unsigned int i = 0; i < cond.size(); i++)
+		aCond.emplace_back(getAtom(cond[i].variable, a.parameters), getObject(cond[i].value, a.parameters));
+}
+
+// Grounds the effects. Returns false if they are contradictory (an atom gets two different values)
+bool LiftedSuccessors::groundEffects(OpCondition &cond, LiftedAction &a, vector< pair<unsigned int, unsigned int> > &aEff,
+	vector< pair<unsigned int, OpEffect*> > &aNumEff) {
+	vector< pair<unsigned int, unsigned int> > eff;
+	for (unsigned int i = 0; i < cond.eff.size(); i++)
+		eff.emplace_back(getAtom(cond.eff[i].variable, a.parameters), getObject(cond.eff[i].value, a.parameters));
+	for (unsigned int i = 0; i < cond.numericEff.size(); i++) {
+		OpEffect &e = cond.numericEff[i];
+		unsigned int atom = getAtom(e.fluent, a.parameters);
+		if (e.assignment == AS_ASSIGN && e.exp.type == OEET_TERM) eff.emplace_back(atom, getObject(e.exp.term, a.parameters));
+		else aNumEff.emplace_back(atom, &e);
+	}
+	for (unsigned int i = 0; i < eff.size(); i++) {
+		bool addEffect = true;
+		for (unsigned int j = 0; j < aEff.size(); j++)
+			if (aEff[j].first == eff[i].first) {
+				if (aEff[j].second != eff[i].second) return false;
+				addEffect = false;
+				break;
+			}
+		if (addEffect) aEff.push_back(eff[i]);
+	}
+	return true;
+}
+
+// Returns the index of the atom of a literal, or MAX_UNSIGNED_INT if it has not been created
+unsigned int LiftedSuccessors::findAtom(Literal &l, vector<unsigned int> &parameters) {
+	atomParams.clear();
+	for (unsigned int i = 0; i < l.params.size(); i++)
+		atomParams.push_back(getObject(l.params[i], parameters));
+	return task->findAtom(l.fncIndex, atomParams);
+}
+
+// Returns the index of the atom of a literal, creating it if it does not exist
+unsigned int LiftedSuccessors::getAtom(Literal &l, vector<unsigned int> &parameters) {
+	atomParams.clear();
+	for (unsigned int i = 0; i < l.params.size(); i++)
+		atomParams.push_back(getObject(l.params[i], parameters));
+	return task->getAtom(l.fncIndex, atomParams);
+}
+
+// Checks if the atom has the given value in the state
+bool LiftedSuccessors::holds(unsigned int atom, unsigned int value, const LiftedState &s) {
+	unsigned int current = task->getValue(s, atom);
+	if (value == task->task->CONSTANT_FALSE) return current == MAX_UNSIGNED_INT;
+	return current == value;
+}
+
+// Checks if the ground conditions hold in the state
+bool LiftedSuccessors::holds(vector< pair<unsigned int, unsigned int> > &cond, const LiftedState &s) {
+	for (unsigned int i = 0; i < cond.size(); i++)
+		if (!holds(cond[i].first, cond[i].second, s)) return false;
+	return true;
+}
+
+// Checks if a numeric condition holds in the state. Conditions on undefined fluents do not hold
+bool LiftedSuccessors::holds(OpNumericPrec &cond, LiftedAction &a, const LiftedState &s, float duration) {
+	float v1, v2;
+	if (!evaluate(cond.operands[0], a, s, duration, &v1) || !evaluate(cond.operands[1], a, s, duration, &v2))
+		return false;
+	switch (cond.comparator) {
+	case CMP_EQ:			return v1 == v2;
+	case CMP_LESS:			return v1 < v2;
+	case CMP_LESS_EQ:		return v1 <= v2;
+	case CMP_GREATER:		return v1 > v2;
+	case CMP_GREATER_EQ:	return v1 >= v2;
+	default:				return v1 != v2;
+	}
+}
+
+// Checks if the numeric conditions hold in the state
+bool LiftedSuccessors::holds(vector<OpNumericPrec> &cond, LiftedAction &a, const LiftedState &s, float duration) {
+	for (unsigned int i = 0; i < cond.size(); i++)
+		if (!holds(cond[i], a, s, duration)) return false;
+	return true;
+}
+
+// Evaluates a numeric expression of the operator. Returns false if it is undefined
+bool LiftedSuccessors::evaluate(OpEffectExpression &e, LiftedAction &a, const LiftedState &s, float duration, float* value) {
+	switch (e.type) {
+	case OEET_NUMBER:
+		*value = e.value;
+		return true;
+	case OEET_DURATION:
+		*value = duration;
+		return true;
+	case OEET_FLUENT: {
+		unsigned int atom = findAtom(e.fluent, a.parameters);
+		return atom != MAX_UNSIGNED_INT && task->getNumValue(s, atom, value);
+	}
+	case OEET_SUM:
+	case OEET_SUB:
+	case OEET_MUL:
+	case OEET_DIV: {
+		if (e.operands.empty() || !evaluate(e.operands[0], a, s, duration, value)) return false;
+		if (e.operands.size() == 1 && e.type == OEET_SUB) *value = -*value;
+		for (unsigned int i = 1; i < e.operands.size(); i++) {
+			float v;
+			if (!evaluate(e.operands[i], a, s, duration, &v)) return false;
+			switch (e.type) {
+			case OEET_SUM:	*value += v;	break;
+			case OEET_SUB:	*value -= v;	break;
+			case OEET_MUL:	*value *= v;	break;
+			default:
+				if (v == 0) return false;
+				*value /= v;
+			}
+		}
+		return true;
+	}
+	default:
+		return false;
+	}
+}
+
+// Evaluates the duration expression of the operator. Returns false if it is undefined
+bool LiftedSuccessors::evaluate(NumericExpression &e, LiftedAction &a, const LiftedState &s, float* value) {
+	switch (e.type) {
+	case NET_NUMBER:
+		*value = e.value;
+		return true;
+	case NET_FUNCTION: {
+		unsigned int atom = findAtom(e.function, a.parameters);
+		return atom != MAX_UNSIGNED_INT && task->getNumValue(s, atom, value);
+	}
+	case NET_NEGATION:
+		if (!evaluate(e.operands[0], a, s, value)) return false;
+		*value = -*value;
+		return true;
+	case NET_SUM:
+	case NET_SUB:
+	case NET_MUL:
+	case NET_DIV: {
+		if (e.operands.empty() || !evaluate(e.operands[0], a, s, value)) return false;
+		for (unsigned int i = 1; i < e.operands.size(); i++) {
+			float v;
+			if (!evaluate(e.operands[i], a, s, &v)) return false;
+			switch (e.type) {
+			case NET_SUM:	*value += v;	break;
+			case NET_SUB:	*value -= v;	break;
+			case NET_MUL:	*value *= v;	break;
+			default:
+				if (v == 0) return false;
+				*value /= v;
+			}
+		}
+		return true;
+	}
+	default:
+		return false;
+	}
+}
+
+// Computes the duration of the action in the state. Instantaneous actions have duration 0
+bool LiftedSuccessors::getDuration(LiftedAction &a, const LiftedState &s, float* duration) {
+	Operator* o = getOperator(a);
+	if (o->duration.empty()) {
+		*duration = 0;
+		return true;
+	}
+	return evaluate(o->duration[0].exp, a, s, duration) && *duration > 0;
+}
+
+// Applies the effects to the state. The numeric effects are evaluated before modifying the state
+bool LiftedSuccessors::applyEffects(LiftedAction &a, vector< pair<unsigned int, unsigned int> > &eff,
+	vector< pair<unsigned int, OpEffect*> > &numEff, float duration, LiftedState &s) {
+	vector< pair<unsigned int, float> > newValues;
+	for (unsigned int i = 0; i < numEff.size(); i++) {
+		OpEffect* e = numEff[i].second;
+		float v, current = 0;
+		if (!evaluate(e->exp, a, s, duration, &v)) return false;
+		if (e->assignment != AS_ASSIGN && !task->getNumValue(s, numEff[i].first, &current)) return false;
+		switch (e->assignment) {
+		case AS_ASSIGN:		break;
+		case AS_INCREASE:	v = current + v;	break;
+		case AS_DECREASE:	v = current - v;	break;
+		case AS_SCALE_UP:	v = current * v;	break;
+		default:
+			if (v == 0) return false;
+			v = current / v;
+		}
+		newValues.emplace_back(numEff[i].first, v);
+	}
+	for (unsigned int i = 0; i < eff.size(); i++) {
+		if (eff[i].second == task->task->CONSTANT_FALSE) s.removeValue(eff[i].first);
+		else s.setValue(eff[i].first, eff[i].second);
+	}
+	for (unsigned int i = 0; i < newValues.size(); i++)
+		s.setNumValue(newValues[i].first, newValues[i].second);
+	return true;
+}
+
+// Applies the action to the state, as a whole: the start effects, and then the end effects. Returns false if
+// the action is not applicable. The over-all and at-end conditions are checked after the start effects
+bool LiftedSuccessors::apply(unsigned int action, const LiftedState &s, LiftedState &next, float* duration) {
+	LiftedAction &a = actions[action];
+	Operator* o = getOperator(a);
+	if (!holds(a.startCond, s) || !getDuration(a, s, duration) || !holds(o->atStart.numericPrec, a, s, *duration))
+		return false;
+	next = s;
+	if (!applyEffects(a, a.startEff, a.startNumEff, *duration, next)) return false;
+	if (!holds(a.overCond, next) || !holds(a.endCond, next) || !holds(o->overAllNumericPrec, a, next, *duration) ||
+		!holds(o->atEnd.numericPrec, a, next, *duration))
+		return false;
+	return applyEffects(a, a.endEff, a.endNumEff, *duration, next);
+}
+
+// Checks if all the conditions of a goal action hold in the state
+bool LiftedSuccessors::holdsConditions(LiftedAction &a, const LiftedState &s) {
+	Operator* o = getOperator(a);
+	return holds(a.startCond, s) && holds(a.overCond, s) && holds(a.endCond, s) &&
+		holds(o->atStart.numericPrec, a, s, 0) && holds(o->overAllNumericPrec, a, s, 0) &&
+		holds(o->atEnd.numericPrec, a, s, 0);
+}
+
+// Checks if the state satisfies the goals, that is, if any instance of a goal operator holds in it
+bool LiftedSuccessors::isGoal(const LiftedState &s) {
+	setState(s);
+	vector<unsigned int> candidates;
+	found = &candidates;
+	for (unsigned int i = 0; i < task->goals.size(); i++) {
+		candidates.clear();
+		join(task->goals[i], true);
+		for (unsigned int j = 0; j < candidates.size(); j++)
+			if (holdsConditions(actions[candidates[j]], s)) return true;
+	}
+	return false;
+}
+
+// Goal-counting heuristic: minimum number of unsatisfied conditions of a goal operator. Goal operators with
+// parameters count as a single condition
+unsigned int LiftedSuccessors::countUnsatisfiedGoals(const LiftedState &s) {
+	unsigned int best = MAX_UNSIGNED_INT;
+	for (unsigned int i = 0; i < task->goals.size(); i++) {
+		LiftedOperator &op = task->goals[i];
+		if (!op.op->parameters.empty()) {
+			best = min(best, 1U);
+			continue;
+		}
+		bindings.clear();
+		LiftedAction &a = actions[getAction(op, true)];
+		if (!a.valid) continue;
+		unsigned int count = 0;
+		vector< pair<unsigned int, unsigned int> >* cond[3] = {&(a.startCond), &(a.overCond), &(a.endCond)};
+		for (unsigned int j = 0; j < 3; j++)
+			for (unsigned int k = 0; k < cond[j]->size(); k++)
+				if (!holds(cond[j]->at(k).first, cond[j]->at(k).second, s)) count++;
+		vector<OpNumericPrec>* numCond[3] = {&(op.op->atStart.numericPrec), &(op.op->overAllNumericPrec), &(op.op->atEnd.numericPrec)};
+		for (unsigned int j = 0; j < 3; j++)
+			for (unsigned int k = 0; k < numCond[j]->size(); k++)
+				if (!holds(numCond[j]->at(k), a, s, 0)) count++;
+		best = min(best, count);
+	}
+	return best;
+}
+
+// Returns the name of the action, as it is written in the plan
+string LiftedSuccessors::getActionName(unsigned int index) {
+	LiftedAction &a = actions[index];
+	string name = getOperator(a)->name;
+	for (unsigned int i = 0; i < a.parameters.size(); i++)
+		name += " " + task->task->objects[a.parameters[i]].name;
+	return name;
+}
@@ -0,0 +1,82 @@
+#ifndef LIFTED_SUCCESSORS_H
+#define LIFTED_SUCCESSORS_H
+
+/********************************************************/
+/* Successor generation of the lifted search: the       */
+/* operators are instantiated by joining their          */
+/* preconditions with the facts of the state, and the   */
+/* ground actions are kept in a cache that grows as     */
+/* new instantiations are found.                        */
+/********************************************************/
+
+#include "liftedTask.hpp"
+
+class LiftedAction {		// Ground action, created on demand from an operator
+public:
+	unsigned int op;
+	bool isGoal;
+	bool valid;				// False if the equality conditions do not hold or the effects are contradictory
+	std::vector<unsigned int> parameters;
+	std::vector< std::pair<unsigned int, unsigned int> > startCond;	// (atom, value)
+	std::vector< std::pair<unsigned int, unsigned int> > overCond;
+	std::vector< std::pair<unsigned int, unsigned int> > endCond;
+	std::vector< std::pair<unsigned int, unsigned int> > startEff;
+	std::vector< std::pair<unsigned int, unsigned int> > endEff;
+	std::vector< std::pair<unsigned int, OpEffect*> > startNumEff;	// (atom, numeric effect)
+	std::vector< std::pair<unsigned int, OpEffect*> > endNumEff;
+};
+
+class LiftedSuccessors {
+private:
+	LiftedTask* task;
+	std::vector<LiftedAction> actions;		// Action cache
+	GrounderTupleIndex* actionIndex;		// Actions by (goal flag, operator, parameters)
+	std::vector<unsigned int> key;
+	const LiftedState* state;
+	std::vector< std::vector<unsigned int> > factsOfFunction;	// Positions in the state of the values of each non-static function
+	std::vector<unsigned int> bindings;
+	std::vector<unsigned int> joinOrder;
+	std::vector<unsigned int>* found;
+	std::vector<unsigned int> atomParams;
+
+	void setState(const LiftedState &s);
+	void join(LiftedOperator &op, bool isGoal);
+	void join(LiftedOperator &op, bool isGoal, unsigned int step);
+	bool unify(LiftedOperator &op, OpFluent* prec, unsigned int atom, unsigned int value, std::vector<unsigned int> &bound);
+	bool bindTerm(LiftedOperator &op, Term &t, unsigned int obj, std::vector<unsigned int> &bound);
+	void bindRemainingParameters(LiftedOperator &op, bool isGoal, unsigned int param);
+	unsigned int getAction(LiftedOperator &op, bool isGoal);
+	void createAction(LiftedAction &a, LiftedOperator &op);
+	void groundConditions(std::vector<OpFluent> &cond, LiftedAction &a, std::vector< std::pair<unsigned int, unsigned int> > &aCond);
+	bool groundEffects(OpCondition &cond, LiftedAction &a, std::vector< std::pair<unsigned int, unsigned int> > &aEff,
+		std::vector< std::pair<unsigned int, OpEffect*> > &aNumEff);
+	unsigned int findAtom(Literal &l, std::vector<unsigned int> &parameters);
+	unsigned int getAtom(Literal &l, std::vector<unsigned int> &parameters);
+	inline unsigned int getObject(Term &t, std::vector<unsigned int> &parameters) {
+		return t.isVariable ? parameters[t.index] : t.index;
+	}
+	bool holds(unsigned int atom, unsigned int value, const LiftedState &s);
+	bool holds(std::vector< std::pair<unsigned int, unsigned int> > &cond, const LiftedState &s);
+	bool holds(OpNumericPrec &cond, LiftedAction &a, const LiftedState &s, float duration);
+	bool holds(std::vector<OpNumericPrec> &cond, LiftedAction &a, const LiftedState &s, float duration);
+	bool evaluate(OpEffectExpression &e, LiftedAction &a, const LiftedState &s, float duration, float* value);
+	bool evaluate(NumericExpression &e, LiftedAction &a, const LiftedState &s, float* value);
+	bool getDuration(LiftedAction &a, const LiftedState &s, float* duration);
+	bool applyEffects(LiftedAction &a, std::vector< std::pair<unsigned int, unsigned int> > &eff,
+		std::vector< std::pair<unsigned int, OpEffect*> > &numEff, float duration, LiftedState &s);
+	bool holdsConditions(LiftedAction &a, const LiftedState &s);
+	inline Operator* getOperator(LiftedAction &a) { return a.isGoal ? task->goals[a.op].op : task->operators[a.op].op; }
+
+public:
+	LiftedSuccessors(LiftedTask* task);
+	~LiftedSuccessors();
+	void getCandidateActions(const LiftedState &s, std::vector<unsigned int> &candidates);
+	bool apply(unsigned int action, const LiftedState &s, LiftedState &next, float* duration);
+	bool isGoal(const LiftedState &s);
+	unsigned int countUnsatisfiedGoals(const LiftedState &s);
+	inline LiftedAction& getAction(unsigned int index) { return actions[index]; }
+	inline unsigned int getNumActions() { return actions.size(); }
+	std::string getActionName(unsigned int index);
+};
+
+#endif
@@ -0,0 +1,232 @@
+/********************************************************/
+/* Lifted representation of the preprocessed task, used */
+/* when the task is too large to be grounded.           */
+/********************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "liftedTask.hpp"
+#include "../grounder/grounder.hpp"
+using namespace std;
+
+/********************************************************/
+/* CLASS: LiftedState                                   */
+/********************************************************/
+
+// Returns the value of a non-static atom, or MAX_UNSIGNED_INT if it is not stored (false or undefined)
+unsigned int LiftedState::getValue(unsigned int atom) const {
+	auto it = lower_bound(values.begin(), values.end(), make_pair(atom, 0U));
+	return it != values.end() && it->first == atom ? it->second : MAX_UNSIGNED_INT;
+}
+
+// Gets the value of a non-static numeric atom. Returns false if it is undefined
+bool LiftedState::getNumValue(unsigned int atom, float* value) const {
+	auto it = lower_bound(numValues.begin(), numValues.end(), atom,
+		[](const pair<unsigned int, float> &v, unsigned int a) { return v.first < a; });
+	if (it == numValues.end() || it->first != atom) return false;
+	*value = it->second;
+	return true;
+}
+
+// Sets the value of an atom
+void LiftedState::setValue(unsigned int atom, unsigned int value) {
+	auto it = lower_bound(values.begin(), values.end(), make_pair(atom, 0U));
+	if (it != values.end() && it->first == atom) it->second = value;
+	else values.emplace(it, atom, value);
+}
+
+// Removes the value of an atom (the atom becomes false)
+void LiftedState::removeValue(unsigned int atom) {
+	auto it = lower_bound(values.begin(), values.end(), make_pair(atom, 0U));
+	if (it != values.end() && it->first == atom) values.erase(it);
+}
+
+// Sets the value of a numeric atom
+void LiftedState::setNumValue(unsigned int atom, float value) {
+	auto it = lower_bound(numValues.begin(), numValues.end(), atom,
+		[](const pair<unsigned int, float> &v, unsigned int a) { return v.first < a; });
+	if (it != numValues.end() && it->first == atom) it->second = value;
+	else numValues.emplace(it, atom, value);
+}
+
+// Returns the hash code of the state
+uint64_t LiftedState::hash() const {
+	uint64_t h = 14695981039346656037ULL;
+	for (unsigned int i = 0; i < values.size(); i++) {
+		h = (h ^ values[i].first) * 1099511628211ULL;
+		h = (h ^ values[i].second) * 1099511628211ULL;
+	}
+	for (unsigned int i = 0; i < numValues.size(); i++) {
+		uint32_t bits;
+		memcpy(&bits, &(numValues[i].second), sizeof(bits));
+		h = (h ^ numValues[i].first) * 1099511628211ULL;
+		h = (h ^ bits) * 1099511628211ULL;
+	}
+	return h;
+}
+
+/********************************************************/
+/* CLASS: LiftedTask                                    */
+/********************************************************/
+
+// Creates the lifted task. The preprocessed task must not be deleted while the lifted task is used
+LiftedTask::LiftedTask(PreprocessedTask* prepTask) {
+	task = prepTask->task;
+	atomIndex = new GrounderTupleIndex();
+	atomParamStart.push_back(0);
+	initOperators(prepTask);
+	initInitialState();
+}
+
+// Disposes the lifted task
+LiftedTask::~LiftedTask() {
+	delete atomIndex;
+}
+
+// Prepares the operators for the joins and detects the static functions
+void LiftedTask::initOperators(PreprocessedTask* prepTask) {
+	unsigned int numFunctions = task->functions.size();
+	staticFunction.assign(numFunctions, true);
+	for (unsigned int i = 0; i < prepTask->operators.size(); i++) {
+		Operator &op = prepTask->operators[i];
+		if (op.isGoal) continue;
+		for (unsigned int j = 0; j < op.atStart.eff.size(); j++)
+			staticFunction[op.atStart.eff[j].variable.fncIndex] = false;
+		for (unsigned int j = 0; j < op.atEnd.eff.size(); j++)
+			staticFunction[op.atEnd.eff[j].variable.fncIndex] = false;
+		for (unsigned int j = 0; j < op.atStart.numericEff.size(); j++)
+			staticFunction[op.atStart.numericEff[j].fluent.fncIndex] = false;
+		for (unsigned int j = 0; j < op.atEnd.numericEff.size(); j++)
+			staticFunction[op.atEnd.numericEff[j].fluent.fncIndex] = false;
+	}
+	for (unsigned int i = 0; i < prepTask->operators.size(); i++) {
+		Operator* op = &(prepTask->operators[i]);
+		vector<LiftedOperator> &v = op->isGoal ? goals : operators;
+		v.emplace_back();
+		initOperator(v.back(), op, v.size() - 1);
+	}
+}
+
+// Computes the objects compatible with each parameter and the preconditions used in the joins. Over-all and
+// at-end preconditions are only joined if the operator does not modify their functions at start
+void LiftedTask::initOperator(LiftedOperator &lo, Operator* op, unsigned int index) {
+	lo.op = op;
+	lo.index = index;
+	unsigned int numObjects = task->objects.size();
+	lo.compatibleObjects.resize(op->parameters.size());
+	lo.isCompatible.assign(op->parameters.size(), vector<bool>(numObjects, false));
+	for (unsigned int i = 0; i < op->parameters.size(); i++)
+		for (unsigned int k = 0; k < numObjects; k++)
+			if (task->compatibleTypes(task->objects[k].types, op->parameters[i].types)) {
+				lo.compatibleObjects[i].push_back(k);
+				lo.isCompatible[i][k] = true;
+			}
+	vector<bool> modifiedAtStart(task->functions.size(), false);
+	for (unsigned int i = 0; i < op->atStart.eff.size(); i++)
+		modifiedAtStart[op->atStart.eff[i].variable.fncIndex] = true;
+	for (unsigned int i = 0; i < op->atStart.numericEff.size(); i++)
+		modifiedAtStart[op->atStart.numericEff[i].fluent.fncIndex] = true;
+	for (unsigned int i = 0; i < op->atStart.prec.size(); i++) {
+		OpFluent &f = op->atStart.prec[i];
+		if (f.value.isVariable || f.value.index != task->CONSTANT_FALSE) lo.joinPrecs.push_back(&f);
+	}
+	for (unsigned int i = 0; i < op->overAllPrec.size(); i++) {
+		OpFluent &f = op->overAllPrec[i];
+		if ((f.value.isVariable || f.value.index != task->CONSTANT_FALSE) && !modifiedAtStart[f.variable.fncIndex])
+			lo.joinPrecs.push_back(&f);
+	}
+	for (unsigned int i = 0; i < op->atEnd.prec.size(); i++) {
+		OpFluent &f = op->atEnd.prec[i];
+		if ((f.value.isVariable || f.value.index != task->CONSTANT_FALSE) && !modifiedAtStart[f.variable.fncIndex])
+			lo.joinPrecs.push_back(&f);
+	}
+}
+
+// Sets the values of the static atoms and the initial state
+void LiftedTask::initInitialState() {
+	staticAtomsOfFunction.resize(task->functions.size());
+	for (unsigned int i = 0; i < task->init.size(); i++) {
+		Fact &f = task->init[i];
+		if (f.time > 0) continue;		// Timed initial literals are not supported
+		if (!f.valueIsNumeric && f.value == task->CONSTANT_FALSE) continue;
+		unsigned int atom = getAtom(f.function, f.parameters);
+		if (staticFunction[f.function]) {
+			if (f.valueIsNumeric) staticNumValue[atom] = f.numericValue;
+			else {
+				if (staticValue[atom] == MAX_UNSIGNED_INT) staticAtomsOfFunction[f.function].push_back(atom);
+				staticValue[atom] = f.value;
+			}
+		} else if (f.valueIsNumeric) initialState.setNumValue(atom, f.numericValue);
+		else initialState.setValue(atom, f.value);
+	}
+}
+
+// Returns the first feature of the task that the lifted search does not support, or an empty string if it is supported
+string LiftedTask::getUnsupportedFeature() {
+	if (!task->constraints.empty()) return "constraints";
+	if (!task->derivedPredicates.empty()) return "derived predicates";
+	for (unsigned int i = 0; i < task->init.size(); i++)
+		if (task->init[i].time > 0) return "timed initial literals";
+	for (unsigned int i = 0; i < operators.size(); i++) {
+		string feature = getUnsupportedFeature(*(operators[i].op));
+		if (!feature.empty()) return feature;
+	}
+	return "";
+}
+
+// Returns the first feature of the operator that the lifted search does not support
+string LiftedTask::getUnsupportedFeature(Operator &op) {
+	if (op.duration.size() > 1 || (op.duration.size() == 1 && (op.duration[0].comp != CMP_EQ ||
+		op.duration[0].time == AT_END || op.duration[0].time == OVER_ALL)))
+		return "durations that are not fixed (in " + op.name + ")";
+	if (hasContinuousEffects(op.atStart.numericEff) || hasContinuousEffects(op.atEnd.numericEff))
+		return "continuous effects (in " + op.name + ")";
+	return "";
+}
+
+// Checks if any of the numeric effects depends on #t
+bool LiftedTask::hasContinuousEffects(vector<OpEffect> &eff) {
+	for (unsigned int i = 0; i < eff.size(); i++)
+		if (hasContinuousEffects(eff[i].exp)) return true;
+	return false;
+}
+
+// Checks if the expression depends on #t
+bool LiftedTask::hasContinuousEffects(OpEffectExpression &e) {
+	if (e.type == OEET_SHARP_T || e.type == OEET_SHARP_T_PRODUCT) return true;
+	for (unsigned int i = 0; i < e.operands.size(); i++)
+		if (hasContinuousEffects(e.operands[i])) return true;
+	return false;
+}
+
+// Returns the index of an atom, or MAX_UNSIGNED_INT if it has not been created
+unsigned int LiftedTask::findAtom(unsigned int fnc, const vector<unsigned int> &params) {
+	key.clear();
+	key.push_back(fnc);
+	key.insert(key.end(), params.begin(), params.end());
+	return atomIndex->find(key);
+}
+
+// Returns the index of an atom, creating it if it does not exist
+unsigned int LiftedTask::getAtom(unsigned int fnc, const vector<unsigned int> &params) {
+	unsigned int atom = findAtom(fnc, params);
+	if (atom == MAX_UNSIGNED_INT) {
+		atom = atomFunction.size();
+		atomIndex->insert(key, atom);
+		atomFunction.push_back(fnc);
+		atomParamList.insert(atomParamList.end(), params.begin(), params.end());
+		atomParamStart.push_back(atomParamList.size());
+		staticValue.push_back(MAX_UNSIGNED_INT);
+		staticNumValue.push_back(NAN);
+	}
+	return atom;
+}
+
+// Gets the value of a numeric atom in the given state. Returns false if it is undefined
+bool LiftedTask::getNumValue(const LiftedState &s, unsigned int atom, float* value) {
+	if (!staticFunction[atomFunction[atom]]) return s.getNumValue(atom, value);
+	if (std::isnan(staticNumValue[atom])) return false;
+	*value = staticNumValue[atom];
+	return true;
+}
@@ -0,0 +1,76 @@
+#ifndef LIFTED_TASK_H
+#define LIFTED_TASK_H
+
+/********************************************************/
+/* Lifted representation of the preprocessed task, used */
+/* when the task is too large to be grounded: atoms are */
+/* created on demand and the states only store the      */
+/* values of the functions modified by the operators.   */
+/********************************************************/
+
+#include "../preprocess/preprocessedTask.hpp"
+
+class GrounderTupleIndex;
+
+class LiftedState {		// Values of the non-static atoms, sorted by atom. False boolean atoms and undefined numeric atoms are not stored
+public:
+	std::vector< std::pair<unsigned int, unsigned int> > values;	// (atom, object)
+	std::vector< std::pair<unsigned int, float> > numValues;		// (atom, numeric value)
+
+	unsigned int getValue(unsigned int atom) const;
+	bool getNumValue(unsigned int atom, float* value) const;
+	void setValue(unsigned int atom, unsigned int value);
+	void removeValue(unsigned int atom);
+	void setNumValue(unsigned int atom, float value);
+	uint64_t hash() const;
+	inline bool operator==(const LiftedState &s) const { return values == s.values && numValues == s.numValues; }
+};
+
+class LiftedOperator {	// Operator prepared to be instantiated by joining its preconditions with the facts of a state
+public:
+	Operator* op;
+	unsigned int index;
+	std::vector< std::vector<unsigned int> > compatibleObjects;	// Objects compatible with each parameter
+	std::vector< std::vector<bool> > isCompatible;
+	std::vector<OpFluent*> joinPrecs;		// Positive preconditions that must hold in the state where the operator starts
+};
+
+class LiftedTask {
+private:
+	GrounderTupleIndex* atomIndex;		// Atoms by (function, parameters)
+	std::vector<unsigned int> key;
+	std::vector<unsigned int> atomParamStart;
+	std::vector<unsigned int> atomParamList;
+
+	void initOperators(PreprocessedTask* prepTask);
+	void initOperator(LiftedOperator &lo, Operator* op, unsigned int index);
+	void initInitialState();
+	std::string getUnsupportedFeature(Operator &op);
+	bool hasContinuousEffects(std::vector<OpEffect> &eff);
+	bool hasContinuousEffects(OpEffectExpression &e);
+
+public:
+	ParsedTask* task;
+	std::vector<LiftedOperator> operators;
+	std::vector<LiftedOperator> goals;
+	std::vector<bool> staticFunction;		// Functions that no operator modifies
+	std::vector<unsigned int> atomFunction;
+	std::vector<unsigned int> staticValue;		// Value of each static atom (MAX_UNSIGNED_INT if false or not static)
+	std::vector<float> staticNumValue;			// Value of each static numeric atom (NaN if undefined or not static)
+	std::vector< std::vector<unsigned int> > staticAtomsOfFunction;	// Static atoms with a value, for the joins
+	LiftedState initialState;
+
+	LiftedTask(PreprocessedTask* prepTask);
+	~LiftedTask();
+	std::string getUnsupportedFeature();
+	unsigned int findAtom(unsigned int fnc, const std::vector<unsigned int> &params);
+	unsigned int getAtom(unsigned int fnc, const std::vector<unsigned int> &params);
+	inline unsigned int getNumAtoms() { return atomFunction.size(); }
+	inline const unsigned int* getAtomParams(unsigned int atom) { return atomParamList.data() + atomParamStart[atom]; }
+	inline unsigned int getValue(const LiftedState &s, unsigned int atom) {
+		return staticFunction[atomFunction[atom]] ? staticValue[atom] : s.getValue(atom);
+	}
+	bool getNumValue(const LiftedState &s, unsigned int atom, float* value);
+};
+
+#endif
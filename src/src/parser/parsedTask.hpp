@@ -362,6 +362,7 @@ public:
     unsigned int addPreference(std::string name, const GoalDescription &goal, SyntaxAnalyzer* syn);
     unsigned int addPreference(const Constraint &c, SyntaxAnalyzer* syn);
     unsigned int getPreferenceIndex(std::string const &name);
+    inline bool hasPreferences() { return !preferences.empty(); }
     bool isNumericFunction(unsigned int fncIndex);
     bool isBooleanFunction(unsigned int fncIndex);
     bool compatibleTypes(const std::vector<unsigned int> &types, const std::vector<unsigned int> &validTypes);
@@ -31,11 +31,23 @@ Linearizer::Linearizer() {
 	for (unsigned int i = 0; i < INITAL_MATRIX_SIZE; i++)
 		matrix[i].resize(INITAL_MATRIX_SIZE, 0);
 	iteration = 0;
+	frontierState = nullptr;
+	auxState = nullptr;
+}
+
+Linearizer::~Linearizer() {
+	if (frontierState != nullptr) delete frontierState;
+	if (auxState != nullptr) delete auxState;
+	for (unsigned int i = 0; i < freePoints.size(); i++) delete freePoints[i];
 }
 
 void Linearizer::setInitialState(TState* initialState, SASTask* task) {
 	this->initialState = initialState;
 	this->task = task;
+	if (frontierState != nullptr) delete frontierState;
+	if (auxState != nullptr) delete auxState;
+	frontierState = new TState(initialState);
+	auxState = new TState(initialState);
 }
 
 // Sets the current plan
@@ -105,8 +117,8 @@ void Linearizer::resizeMatrix() {
 void Linearizer::topologicalOrder(std::vector<TTimePoint>* linearOrder) {
 	unsigned int size = linearOrder->size();
 	//cout << "SIZE = " << size << endl;
-	vector<bool> visited(size, false);
-	topologicalOrder(1, linearOrder, size - 1, &visited);
+	visitedPoints.assign(size, false);
+	topologicalOrder(1, linearOrder, size - 1, &visitedPoints);
 }
 
 // Recursively linearizes the plan
@@ -130,13 +142,7 @@ TState* Linearizer::getFrontierState(SASTask* task, LandmarkHeuristic* hLand) {
 	unsigned int numActions = basePlanComponents.size();
 	if (plan != nullptr) numActions++;
 	unsigned int numTimeSteps = numActions << 1; //linearOrder->size() + 1;
-	TState* state = linearize(numActions, numTimeSteps, task, hLand);
-	if (state != nullptr) {
-		//if (timeNewStep != nullptr) *timeNewStep = time[numTimeSteps - 1];
-		delete[] time;
-		delete[] duration;
-	}
-	return state;
+	return linearize(numActions, numTimeSteps, task, hLand);
 }
 
 // Returns a string representation of the plan in PDDL format 
@@ -161,9 +167,6 @@ string Linearizer::planToPDDL(Plan* p, SASTask* task) {
 				numPlanActions++;
 			}
 		}
-		delete state;
-		delete[] time;
-		delete[] duration;
 	}
 	std::ostringstream oss;
 	oss << std::setprecision(3) << std::fixed;
@@ -182,32 +185,31 @@ string Linearizer::planToPDDL(Plan* p, SASTask* task) {
 // action schedule, nullptr is returned
 TState* Linearizer::linearize(unsigned int numActions, unsigned int numTimeSteps, SASTask* task, LandmarkHeuristic* hLand) {
 	bool invalidPlan = false;
-	vector<TTimePoint> linearOrder(numTimeSteps);
+	linearOrder.assign(numTimeSteps, 0);
 	SASAction* lastAction = getLastAction();
 	bool isSolution = lastAction->isGoal;
 	topologicalOrder(&linearOrder);
 	initializeTimeArray(numTimeSteps);  				// Store in an array time[t] the time for each time point t in the plan
-	duration = new double[numActions];
+	duration.resize(numActions);
 	initialPlanSchedule(&linearOrder, numTimeSteps);
 	if (task->tilActions && !checkValidInitialSchedule(&linearOrder)) return nullptr;
-	TState* state = new TState(initialState);			// Make a copy of the initial state
+	TState* state = frontierState;
+	state->copyValues(initialState);					// Start from the initial state
 	bool repeat = true;
 	unsigned int numRepairings = 0;
 	while (repeat) {
 		if (!isSolution) fixScheduledTimes(numTimeSteps, state, &repeat, &invalidPlan, &linearOrder);
 		else fixScheduledTimesForGoal(numTimeSteps, state, &repeat, &invalidPlan, &linearOrder);
 		if (invalidPlan) {
-			delete state;
 			break;
 		}
 		if (repeat) {
-			delete state;
 			numRepairings++;
 			if (numRepairings >= numTimeSteps) {
 				invalidPlan = true;
 				break;
 			}
-			state = new TState(initialState);			// Make a copy of the initial state
+			state->copyValues(initialState);			// Start again from the initial state
 		}
 	}
 	if (isSolution && !invalidPlan) {
@@ -225,20 +227,18 @@ TState* Linearizer::linearize(unsigned int numActions, unsigned int numTimeSteps
 		if (hLand != nullptr) {	// Calculate hLand heuristic value
 			computeAchievedLandmarks(numTimeSteps, hLand);
 		}
-	} else {
-		delete[] time;
-		delete[] duration;
 	}
 	return invalidPlan ? nullptr : state;
 }
 
 void Linearizer::computeAchievedLandmarks(unsigned int numTimeSteps, LandmarkHeuristic* hLand) {
 	initializeOpenNodes(hLand);
-	TState state(initialState);			// Make a copy of the initial state
+	TState* state = auxState;
+	state->copyValues(initialState);	// Start from the initial state
 	pq.clear();
 	for (unsigned int i = 2; i < numTimeSteps; i++) {
 		Plan* p = getPlan(i >> 1);
-		pq.add(new ScheduledPoint(i, time[i], p));
+		pq.add(newScheduledPoint(i, time[i], p));
 	}
 	ScheduledPoint *p;
 	unsigned int j;
@@ -248,13 +248,13 @@ void Linearizer::computeAchievedLandmarks(unsigned int numTimeSteps, LandmarkHeu
 		p = (ScheduledPoint*) pq.poll();
 		a = p->plan->action;
 		//cout << "Executing " << p->a->name << endl;
-		updateState(p->p, a, &state, duration[p->p >> 1]);
-		delete p;
+		updateState(p->p, a, state, duration[p->p >> 1]);
+		releasePoint(p);
 		j = 0;
 		while (j < openNodes.size()) {
 			l = openNodes[j];
 			//cout << "Landmark " << l->toString(task, false) << endl;
-			if (l->goOn(&state)) {	// The landmark holds in the state and we can progress
+			if (l->goOn(state)) {	// The landmark holds in the state and we can progress
 				l->check();
 				openNodes.erase(openNodes.begin() + j); // Remove node from the open nodes list
 				for (unsigned int k = 0; k < l->numNext(); k++) { // Go to the adjacent nodes
@@ -273,13 +273,14 @@ void Linearizer::computeAchievedLandmarks(unsigned int numTimeSteps, LandmarkHeu
 
 bool Linearizer::checkSolution(unsigned int numTimeSteps) {
 	//cout << "---------------- SOL -------------" << endl;
-	std::vector<SASAction*> ongoingActions;
-	std::vector<TStep> ongoingSteps;
+	ongoingActions.clear();
+	ongoingSteps.clear();
 	pq.clear();
-	TState state(initialState);			// Make a copy of the initial state
+	TState* state = auxState;
+	state->copyValues(initialState);	// Start from the initial state
 	for (unsigned int i = 2; i < numTimeSteps; i++) {
 		Plan* p = getPlan(i >> 1);
-		pq.add(new ScheduledPoint(i, time[i], p));
+		pq.add(newScheduledPoint(i, time[i], p));
 	}
 	bool ok = true;
 	while (pq.size() > 0 && ok) {
@@ -296,12 +297,12 @@ bool Linearizer::checkSolution(unsigned int numTimeSteps) {
 			//}
 			ongoingActions.push_back(a);
 			ongoingSteps.push_back(step);
-			double dur = computeActionDuration(step, &state);
+			double dur = computeActionDuration(step, state);
 			if (abs(dur - (time[tp + 1] - time[tp])) > EPSILON / 2) ok = false;
-			if (!checkConditions(&a->startCond, &state) || 
-				!checkNumericConditions(&a->startNumCond, &state, dur)) ok = false;
-			updateState(&a->startEff, &state);
-			updateState(&a->startNumEff, &state, dur);
+			if (!checkConditions(&a->startCond, state) || 
+				!checkNumericConditions(&a->startNumCond, state, dur)) ok = false;
+			updateState(&a->startEff, state);
+			updateState(&a->startNumEff, state, dur);
 		}
 		else {					// End action point
 			//cout << " [end]" << endl;
@@ -313,20 +314,20 @@ bool Linearizer::checkSolution(unsigned int numTimeSteps) {
 				}
 			}
 			double dur = this->duration[step];
-			if (!checkConditions(&a->overCond, &state) ||
-				!checkNumericConditions(&a->overNumCond, &state, dur)) ok = false;
-			if (!checkConditions(&a->endCond, &state) ||
-				!checkNumericConditions(&a->endNumCond, &state, dur)) ok = false;
-			updateState(&a->endEff, &state);
-			updateState(&a->endNumEff, &state, dur);
-		}
-		delete p;
+			if (!checkConditions(&a->overCond, state) ||
+				!checkNumericConditions(&a->overNumCond, state, dur)) ok = false;
+			if (!checkConditions(&a->endCond, state) ||
+				!checkNumericConditions(&a->endNumCond, state, dur)) ok = false;
+			updateState(&a->endEff, state);
+			updateState(&a->endNumEff, state, dur);
+		}
+		releasePoint(p);
 		for (unsigned int i = 0; i < ongoingActions.size(); i++) {
 			a = ongoingActions[i];
 			step = ongoingSteps[i];
 			double dur = this->duration[step];
-			if (!checkConditions(&a->overCond, &state) ||
-				!checkNumericConditions(&a->overNumCond, &state, dur)) ok = false;
+			if (!checkConditions(&a->overCond, state) ||
+				!checkNumericConditions(&a->overNumCond, state, dur)) ok = false;
 		}
 	}
 	//if (!ok) cout << "INVALID!!!" << endl;
@@ -373,17 +374,16 @@ void Linearizer::fixScheduledTimes(unsigned int numTimeSteps, TState* state, boo
 		if (p->fixedEnd >= 0) {
 			if (((i & 1) == 0 && time[i] >= 1.5*EPSILON) ||
 				((i & 1) == 1 && abs(time[i] - p->fixedEnd - EPSILON) >= EPSILON)) {
-				for (unsigned int j = 1; j <= pq.size(); j++) delete (ScheduledPoint*)pq.at(j);
-				pq.clear();
+				releaseQueuedPoints();
 				*invalidPlan = true;
 				return;
 			}
 		}
-		pq.add(new ScheduledPoint(i, time[i], p));
+		pq.add(newScheduledPoint(i, time[i], p));
 		//if (debug) cout << i << " -> " << p->action->name << " -> " << time[i] << endl;
 	}
 	ScheduledPoint *p;
-	std::vector<TTimePoint> unsatisfiedNumCond;
+	unsatisfiedNumCond.clear();
 	TTimePoint tp;
 	bool start;
 	double dur;
@@ -405,9 +405,8 @@ void Linearizer::fixScheduledTimes(unsigned int numTimeSteps, TState* state, boo
 				} else {
 					*invalidPlan = true;
 				}
-				delete p;
-				for (unsigned int j = 1; j <= pq.size(); j++) delete (ScheduledPoint*)pq.at(j);
-				pq.clear();
+				releasePoint(p);
+				releaseQueuedPoints();
 				*repeat = true;
 				break;
 			}
@@ -420,11 +419,11 @@ void Linearizer::fixScheduledTimes(unsigned int numTimeSteps, TState* state, boo
 				if (existOrder(tp, sp->p)) {
 					pq.fastRemove(i);
 					unsatisfiedNumCond.push_back(sp->p);
-					delete sp;
+					releasePoint(sp);
 				} else i++;
 			}
 			pq.fix();
-			delete p;
+			releasePoint(p);
 		} else {
 			updateState(tp, a, state, dur);
 			//if (debug) cout << tp << " -> " << a->name << " -> " << p->time << endl;
@@ -432,14 +431,13 @@ void Linearizer::fixScheduledTimes(unsigned int numTimeSteps, TState* state, boo
 				for (unsigned int i = 0; i < unsatisfiedNumCond.size(); i++) {
 					if (existOrder(unsatisfiedNumCond[i], tp)) {
 						*invalidPlan = true;
-						for (unsigned int j = 1; j <= pq.size(); j++) delete (ScheduledPoint*)pq.at(j);
-						pq.clear();
+						releaseQueuedPoints();
 						break;
 					}
 				}
 				checkUnsatisfiedConditions(p->time + EPSILON, state, &unsatisfiedNumCond);
 			}
-			delete p;
+			releasePoint(p);
 		}
 	}
 	if (!unsatisfiedNumCond.empty() && plan != nullptr) plan->unsatisfiedNumericConditions = true;
@@ -461,18 +459,17 @@ void Linearizer::fixScheduledTimesForGoal(unsigned int numTimeSteps, TState* sta
 		if (p->fixedEnd >= 0) {
 			if (((i & 1) == 0 && time[i] >= 1.5*EPSILON) ||
 				((i & 1) == 1 && abs(time[i] - p->fixedEnd - EPSILON) >= EPSILON)) {
-				for (unsigned int j = 1; j <= pq.size(); j++) delete (ScheduledPoint*)pq.at(j);
-				pq.clear();
+				releaseQueuedPoints();
 				*invalidPlan = true;
 				return;
 			}
 		}
-		pq.add(new ScheduledPoint(i, time[i], p));
+		pq.add(newScheduledPoint(i, time[i], p));
 		//cout << i << " -> " << p->action->name << " -> " << time[i] << endl;
 	}
 	ScheduledPoint *p;
-	std::vector<ScheduledPoint*> sameTime;
-	std::vector<TTimePoint> unsatisfiedNumCond;
+	sameTime.clear();
+	unsatisfiedNumCond.clear();
 	double currentTime = 0;
 	TTimePoint tp;
 	bool start;
@@ -495,9 +492,8 @@ void Linearizer::fixScheduledTimesForGoal(unsigned int numTimeSteps, TState* sta
 				} else {
 					*invalidPlan = true;
 				}
-				delete p;
-				for (unsigned int j = 1; j <= pq.size(); j++) delete (ScheduledPoint*)pq.at(j);
-				pq.clear();
+				releasePoint(p);
+				releaseQueuedPoints();
 				*repeat = true;
 				break;
 			}
@@ -511,8 +507,7 @@ void Linearizer::fixScheduledTimesForGoal(unsigned int numTimeSteps, TState* sta
 						if (delayTimePoints(p)) {
 							delayed = true;
 						} else {
-							for (unsigned int j = 1; j <= pq.size(); j++) delete (ScheduledPoint*)pq.at(j);
-							pq.clear();
+							releaseQueuedPoints();
 							*repeat = true;
 						}
 						break;
@@ -522,9 +517,8 @@ void Linearizer::fixScheduledTimesForGoal(unsigned int numTimeSteps, TState* sta
 							if (existOrder(tp - 1, j)) time[j] += EPSILON;
 						}
 						*repeat = true;	// We must repeat the checking as we updated the starting time later
-						for (unsigned int j = 1; j <= pq.size(); j++) delete (ScheduledPoint*)pq.at(j);
-						pq.clear();
-						delete p;
+						releaseQueuedPoints();
+						releasePoint(p);
 						break;
 					}
 				}
@@ -533,7 +527,7 @@ void Linearizer::fixScheduledTimesForGoal(unsigned int numTimeSteps, TState* sta
 			if (delayed) continue;
 		} else {
 			currentTime = p->time;
-			for (unsigned int i = 0; i < sameTime.size(); i++) delete sameTime[i];
+			for (unsigned int i = 0; i < sameTime.size(); i++) releasePoint(sameTime[i]);
 			sameTime.clear();
 		}
 		if (!checkNumericConditions(tp, a, state, dur)) {
@@ -544,11 +538,11 @@ void Linearizer::fixScheduledTimesForGoal(unsigned int numTimeSteps, TState* sta
 				if (existOrder(tp, sp->p)) {
 					pq.fastRemove(i);
 					unsatisfiedNumCond.push_back(sp->p);
-					delete sp;
+					releasePoint(sp);
 				} else i++;
 			}
 			pq.fix();
-			delete p;
+			releasePoint(p);
 		} else {
 			sameTime.push_back(p);
 			updateState(tp, a, state, dur);
@@ -558,7 +552,7 @@ void Linearizer::fixScheduledTimesForGoal(unsigned int numTimeSteps, TState* sta
 			}
 		}
 	}
-	for (unsigned int i = 0; i < sameTime.size(); i++) delete sameTime[i];
+	for (unsigned int i = 0; i < sameTime.size(); i++) releasePoint(sameTime[i]);
 	if (!unsatisfiedNumCond.empty() && plan != nullptr) plan->unsatisfiedNumericConditions = true;
 	/*
 	cout << "Repeat: " << *repeat << endl;
@@ -573,7 +567,7 @@ void Linearizer::fixScheduledTimesForGoal(unsigned int numTimeSteps, TState* sta
 
 void Linearizer::checkUnsatisfiedConditions(double currentTime, TState* state, std::vector<TTimePoint>* unsatisfiedNumCond) {
 	unsigned int i = 0;
-	std::vector<TTimePoint> alreadyDelayed;
+	alreadyDelayed.clear();
 	while (i < unsatisfiedNumCond->size()) {
 		TTimePoint tp = unsatisfiedNumCond->at(i);
 		TStep step = tp >> 1;
@@ -597,11 +591,11 @@ void Linearizer::checkUnsatisfiedConditions(double currentTime, TState* state, s
 				}
 				unsatisfiedNumCond->erase(unsatisfiedNumCond->begin() + i);
 				if (delayed) {
-					pq.add(new ScheduledPoint(tp, time[tp], p));
+					pq.add(newScheduledPoint(tp, time[tp], p));
 				} else {
 					double delay = currentTime - time[tp];
 					time[tp] = currentTime;
-					pq.add(new ScheduledPoint(tp, currentTime, p));
+					pq.add(newScheduledPoint(tp, currentTime, p));
 					for (unsigned int j = i; j < unsatisfiedNumCond->size(); j++) {
 						TTimePoint np = unsatisfiedNumCond->at(j);
 						if (existOrder(tp, np)) {
@@ -670,7 +664,8 @@ void Linearizer::initialPlanSchedule(std::vector<TTimePoint>* linearOrder, unsig
 	numTimeSteps--;
 	TTimePoint p1, p2;
 	bool startPoint;
-	float* numState = new float[numNumVars];
+	scheduleNumState.resize(numNumVars);
+	float* numState = scheduleNumState.data();
 	for (i = 0; i < numNumVars; i++) numState[i] = initialState->numState[i];
 	for (i = 2; i <= numTimeSteps; i++) {
 		p1 = (*linearOrder)[i];
@@ -695,7 +690,6 @@ void Linearizer::initialPlanSchedule(std::vector<TTimePoint>* linearOrder, unsig
 		}
 		//cout << "Time of " << p1 << " is initially " << time[p1] << "(" << a1->name << ")" << endl;
 	}
-	delete[] numState;
 }
 
 void Linearizer::initializeOpenNodes(LandmarkHeuristic* hLand) {
@@ -850,74 +844,13 @@ bool Linearizer::schedulePlan(vector<TTimePoint>* linearOrder, unsigned int numT
 	return true;
 }*/
 
-bool Linearizer::checkNumericMutex(std::vector<SASNumericEffect>* e1, std::vector<SASNumericEffect>* e2) {
-	for (unsigned int i = 0; i < e1->size(); i++) {
-		TVariable v = e1->at(i).var;
-		for (unsigned int j = 0; j < e2->size(); j++) {
-			if (e2->at(j).var == v) {
-				return true;
-			}
-		}
-	}
-	return false;
-}
-
-bool Linearizer::variableInNumericExpression(TVariable v, SASNumericExpression* e) {
-	if (e->type == 'V') return e->var == v;
-	else {
-		for (unsigned int i = 0; i < e->terms.size(); i++) {
-			if (variableInNumericExpression(v, &e->terms[i]))
-				return true;
-		}
-	}
-	return false;
-}
-
-bool Linearizer::variableInCondition(TVariable v, SASNumericCondition* c) {
-	for (unsigned int i = 0; i < c->terms.size(); i++) {
-		if (variableInNumericExpression(v, &c->terms[i])) return true;
-	}
-	return false;
-}
-
-bool Linearizer::checkNumericMutex(std::vector<SASNumericCondition>* c, std::vector<SASNumericEffect>* e) {
-	for (unsigned int i = 0; i < e->size(); i++) {
-		TVariable v = e->at(i).var;
-		for (unsigned int j = 0; j < c->size(); j++) {
-			if (variableInCondition(v, &c->at(j))) return true;
-		}
-	}
-	return false;
-}
-
+// Checks if the numeric conditions or effects of a1 in time point p1 interfere with the ones of a2 in time point p2
 bool Linearizer::checkNumericMutex(TTimePoint p1, SASAction* a1, TTimePoint p2, SASAction* a2) {
-	if ((p1 & 1) == 0) {	// Start of a1
-		if ((p2 & 1) == 0) {	// Start of a2
-			// Start effect of a1 with start effect of a2
-			if (checkNumericMutex(&a1->startNumEff, &a2->startNumEff)) return true;
-			if (checkNumericMutex(&a1->startNumCond, &a2->startNumEff)) return true;
-			if (checkNumericMutex(&a2->startNumCond, &a1->startNumEff)) return true;
-		} else {				// End of a2
-			// Start effect of a1 with end effect of a2
-			if (checkNumericMutex(&a1->startNumEff, &a2->endNumEff)) return true;
-			if (checkNumericMutex(&a1->startNumCond, &a2->endNumEff)) return true;
-			if (checkNumericMutex(&a2->endNumCond, &a1->startNumEff)) return true;
-		}
-	} else {					// End of a1
-		if ((p2 & 1) == 0) {	// Start of a2
-			// End effect of a1 with start effect of a2
-			if (checkNumericMutex(&a1->endNumEff, &a2->startNumEff)) return true;
-			if (checkNumericMutex(&a1->endNumCond, &a2->startNumEff)) return true;
-			if (checkNumericMutex(&a2->startNumCond, &a1->endNumEff)) return true;
-		}
-		else {				// End of a2
-			// End effect of a1 with end effect of a2
-			if (checkNumericMutex(&a1->endNumEff, &a2->endNumEff)) return true;
-			if (checkNumericMutex(&a1->endNumCond, &a2->endNumEff)) return true;
-			if (checkNumericMutex(&a2->endNumCond, &a1->endNumEff)) return true;
-		}
-	}
-	return false;
+	SignatureSet &read1 = (p1 & 1) == 0 ? a1->startNumRead : a1->endNumRead;
+	SignatureSet &write1 = (p1 & 1) == 0 ? a1->startNumWrite : a1->endNumWrite;
+	SignatureSet &read2 = (p2 & 1) == 0 ? a2->startNumRead : a2->endNumRead;
+	SignatureSet &write2 = (p2 & 1) == 0 ? a2->startNumWrite : a2->endNumWrite;
+	return write1.intersects(write2) || read1.intersects(write2) || read2.intersects(write1);
 }
 
 // Actual time-point p is the beginning point of an action
@@ -928,33 +861,11 @@ bool Linearizer::checkNumericMutexWithStartPoint(TTimePoint p, TTimePoint prev,
 	if (aPrev->startNumEff.empty() && aPrev->endNumEff.empty()) return false;
 	//if (a->name.compare("board p1 fast1 f6") == 0 && aPrev->name.compare("board p4 fast1 f6") == 0);
 	//	cout << "AQUI" << endl;
-	TVariable v;
 	if ((prev & 1) == 0) {	// Start point together with previous start point
-		for (unsigned int i = 0; i < a->startNumEff.size(); i++) {
-			v = a->startNumEff[i].var;
-			for (unsigned int j = 0; j < aPrev->startNumEff.size(); j++) {
-				if (aPrev->startNumEff[j].var == v) {
-					return true;
-				}
-			}
-		}
-		for (unsigned int i = 0; i < a->endNumEff.size(); i++) {
-			v = a->endNumEff[i].var;
-			for (unsigned int j = 0; j < aPrev->endNumEff.size(); j++) {
-				if (aPrev->endNumEff[j].var == v) {
-					return true;
-				}
-			}
-		}
+		if (a->startNumWrite.intersects(aPrev->startNumWrite)) return true;
+		if (a->endNumWrite.intersects(aPrev->endNumWrite)) return true;
 	} else {	// Start point together with previous end point
-		for (unsigned int i = 0; i < a->startNumEff.size(); i++) {
-			v = a->startNumEff[i].var;
-			for (unsigned int j = 0; j < aPrev->endNumEff.size(); j++) {
-				if (aPrev->endNumEff[j].var == v) {
-					return true;
-				}
-			}
-		}
+		if (a->startNumWrite.intersects(aPrev->endNumWrite)) return true;
 	}
 	return false;
 }
@@ -1030,7 +941,7 @@ TState* Linearizer::copyInitialState(SASTask* task) {
 //	* Time[1] = 0			(end of the initial fictitious action)
 //	* Time[t] = epsilon, forall t > 1
 void Linearizer::initializeTimeArray(unsigned int numTimeSteps) {
-	time = new double[numTimeSteps];
+	time.resize(numTimeSteps);
 	time[0] = -EPSILON;
 	time[1] = 0;
 	for (unsigned int i = 2; i < numTimeSteps; i++)
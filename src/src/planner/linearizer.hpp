@@ -53,12 +53,38 @@ private:
 	std::vector<Plan*> basePlanComponents;				// The base plan is made up by incremental components, which are stored in this vector
 	std::vector< std::vector<unsigned int> > matrix;	// Orders between time points in the current plan
 	unsigned int iteration;								// Current iteration
-	double* time;										// Starting time of each time step (for computing the frontier state)
-	double* duration;									// Duration of the actions in the plan
+	std::vector<double> time;							// Starting time of each time step (for computing the frontier state)
+	std::vector<double> duration;						// Duration of the actions in the plan
 	std::vector<LandmarkCheck*> openNodes;				// For hLand calculation
 	TState* initialState;
+	TState* frontierState;								// Frontier state of the last linearized plan
+	TState* auxState;									// For internal calculations
 	std::unordered_map<double, TTimePoint> numericMutex;
 	PriorityQueue pq;
+	std::vector<ScheduledPoint*> freePoints;			// Scheduled points not in use, to be reused
+	std::vector<TTimePoint> linearOrder;				// For internal calculations. The following buffers are reused
+	std::vector<bool> visitedPoints;					// between linearizations to avoid memory allocations
+	std::vector<float> scheduleNumState;
+	std::vector<ScheduledPoint*> sameTime;
+	std::vector<TTimePoint> unsatisfiedNumCond;
+	std::vector<TTimePoint> alreadyDelayed;
+	std::vector<SASAction*> ongoingActions;
+	std::vector<TStep> ongoingSteps;
+
+	inline ScheduledPoint* newScheduledPoint(TTimePoint tp, double t, Plan* pl) {
+		if (freePoints.empty()) return new ScheduledPoint(tp, t, pl);
+		ScheduledPoint* p = freePoints.back();
+		freePoints.pop_back();
+		p->p = tp;
+		p->time = t;
+		p->plan = pl;
+		return p;
+	}
+	inline void releasePoint(ScheduledPoint* p) { freePoints.push_back(p); }
+	inline void releaseQueuedPoints() {
+		for (unsigned int j = 1; j <= pq.size(); j++) releasePoint((ScheduledPoint*)pq.at(j));
+		pq.clear();
+	}
 
 	void computeBasePlanSubcomponents(Plan* base);		// Fills the basePlanComponents vector
 	void computeOrderMatrix();							// Computes the order relationships among time points
@@ -96,10 +122,6 @@ private:
 		return step < basePlanComponents.size() ? basePlanComponents[step] : plan;
 	}
 	bool checkValidInitialSchedule(std::vector<TTimePoint>* linearOrder);
-	bool checkNumericMutex(std::vector<SASNumericEffect>* e1, std::vector<SASNumericEffect>* e2);
-	bool checkNumericMutex(std::vector<SASNumericCondition>* c, std::vector<SASNumericEffect>* e);
-	bool variableInCondition(TVariable v, SASNumericCondition* c);
-	bool variableInNumericExpression(TVariable v, SASNumericExpression* e);
 	bool checkSolution(unsigned int numTimeSteps);
 	bool checkConditions(std::vector<SASCondition>* c, TState* state);
 	bool checkNumericConditions(std::vector<SASNumericCondition>* c, TState* state, double dur);
@@ -111,6 +133,7 @@ public:
 	//bool debug = false;
 
 	Linearizer();
+	~Linearizer();
 	void setInitialState(TState* initialState, SASTask* task);
 	void setCurrentBasePlan(Plan* plan);
 	inline void setCurrentPlan(Plan* plan) { this->plan = plan; }
@@ -123,6 +146,7 @@ public:
 	inline Plan* getComponent(unsigned int i)            { return basePlanComponents[i]; }
 	inline unsigned int getIteration()					 { return iteration; }
 	void topologicalOrder(std::vector<TTimePoint>* linearOrder);
+	// The returned states belong to the linearizer and are only valid until the next linearization
 	TState* linearize(unsigned int numActions, unsigned int numTimeSteps, SASTask* task, LandmarkHeuristic* hLand);
 	TState* getFrontierState(SASTask* task, LandmarkHeuristic* hLand); //, double* timeNewStep);
 	std::string planToPDDL(Plan* p, SASTask* task);
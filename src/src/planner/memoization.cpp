@@ -6,28 +6,240 @@
 /********************************************************/
 
 #include <iostream>
+#include <algorithm>
 #include "memoization.hpp"
 using namespace std;
 
 #define INITIAL_MEMO_SIZE	15121
 
+// Swaps the objects o1 and o2 in the name of a SAS variable, value or action: "(f o1 o3)" -> "(f o2 o3)",
+// "a o1 o3" -> "a o2 o3"
+static string swapObjects(const string &name, const string &o1, const string &o2) {
+	if (name == o1) return o2;
+	if (name == o2) return o1;
+	bool parenthesized = name.size() >= 2 && name[0] == '(' && name[name.size() - 1] == ')';
+	if (!parenthesized && name.find(' ') == string::npos) return name;
+	string res = parenthesized ? "(" : "";
+	size_t start = parenthesized ? 1 : 0, end = parenthesized ? name.size() - 1 : name.size();
+	bool first = true;
+	while (start < end) {
+		size_t space = name.find(' ', start);
+		if (space > end) space = end;
+		string token = name.substr(start, space - start);
+		if (!first && token == o1) res += o2;
+		else if (!first && token == o2) res += o1;
+		else res += token;
+		if (space < end) res += " ";
+		first = false;
+		start = space + 1;
+	}
+	return parenthesized ? res + ")" : res;
+}
+
+// Returns the representative (lowest index) of the orbit of the action
+static unsigned int findOrbit(vector<unsigned int> &orbit, unsigned int a) {
+	while (orbit[a] != a) a = orbit[a] = orbit[orbit[a]];
+	return a;
+}
+
 /********************************************************/
 /* CLASS: Memoization                                   */
 /********************************************************/
 
 Memoization::Memoization() {
 	task = nullptr;
+	initialState = canonicalInitialState = nullptr;
+	canonicalState = canonicalFrontierState = permutedState = nullptr;
 	memo.reserve(INITIAL_MEMO_SIZE);
 }
 
+Memoization::~Memoization() {
+	clear();
+	if (canonicalInitialState != initialState) delete canonicalInitialState;
+	delete initialState;
+	delete canonicalState;
+	delete canonicalFrontierState;
+	delete permutedState;
+}
+
 void Memoization::initialize(SASTask* task) {
 	this->task = task;
 	initialState = new TState(task);
 	linearizer.setInitialState(initialState, task);
+	canonicalInitialState = initialState;
+	computePermutations();
 	isRepeatedState(nullptr, initialState);
 }
 
+// Computes the permutations of the state variables for each pair of objects in the same orbit. The pairs whose
+// swap does not map the SAS variables onto themselves (for example, because of asymmetric mutex groups) are discarded
+void Memoization::computePermutations() {
+	permutations.clear();
+	if (task->symmetricObjects.empty()) return;
+	unordered_map<string, unsigned int> valueIndex, numVarIndex;
+	map< pair<string, vector<unsigned int> >, unsigned int> varIndex;	// Variables by name (if any) and values
+	for (unsigned int i = 0; i < task->values.size(); i++)
+		valueIndex[task->values[i].name] = i;
+	for (unsigned int i = 0; i < task->numVariables.size(); i++)
+		numVarIndex[task->numVariables[i].name] = i;
+	for (unsigned int i = 0; i < task->variables.size(); i++) {
+		SASVariable &v = task->variables[i];
+		vector<unsigned int> values = v.possibleValues;
+		sort(values.begin(), values.end());
+		varIndex[make_pair(!v.name.empty() && v.name[0] == '(' ? v.name : "", values)] = i;
+	}
+	unordered_map<string, unsigned int> actionIndex;
+	bool uniqueActionNames = true;
+	for (unsigned int i = 0; i < task->actions.size() && uniqueActionNames; i++)
+		uniqueActionNames = actionIndex.emplace(task->actions[i].name, i).second;
+	vector<unsigned int> actionOrbit(task->actions.size());
+	for (unsigned int i = 0; i < actionOrbit.size(); i++)
+		actionOrbit[i] = i;
+	for (unsigned int i = 0; i < task->symmetricObjects.size(); i++) {
+		vector<string> &orbit = task->symmetricObjects[i];
+		for (unsigned int j = 0; j < orbit.size(); j++)
+			for (unsigned int k = j + 1; k < orbit.size(); k++) {
+				permutations.emplace_back();
+				if (!computePermutation(orbit[j], orbit[k], valueIndex, varIndex, numVarIndex, permutations.back()))
+					permutations.pop_back();
+				else if (uniqueActionNames)
+					joinActionOrbits(orbit[j], orbit[k], permutations.back(), actionIndex, actionOrbit);
+			}
+	}
+	if (permutations.empty()) return;
+	symmetricAction.assign(task->actions.size(), false);
+	for (unsigned int i = 0; i < actionOrbit.size(); i++)
+		symmetricAction[i] = findOrbit(actionOrbit, i) != i;
+	canonicalState = new TState(task);
+	canonicalFrontierState = new TState(task);
+	permutedState = new TState(task);
+	canonicalInitialState = canonicalize(initialState, new TState(task));
+}
+
+// Computes the permutation of the state variables when the objects o1 and o2 are swapped. Returns false if it is
+// not a permutation or if it does not change any variable
+bool Memoization::computePermutation(const string &o1, const string &o2, unordered_map<string, unsigned int> &valueIndex,
+	map< pair<string, vector<unsigned int> >, unsigned int> &varIndex, unordered_map<string, unsigned int> &numVarIndex,
+	StatePermutation &p) {
+	bool changed = false;
+	p.value.resize(task->values.size());
+	for (unsigned int i = 0; i < task->values.size(); i++) {
+		string name = swapObjects(task->values[i].name, o1, o2);
+		unordered_map<string, unsigned int>::iterator it = valueIndex.find(name);
+		if (it == valueIndex.end()) return false;
+		p.value[i] = it->second;
+		if (it->second != i) changed = true;
+	}
+	vector<bool> used(task->variables.size(), false);
+	p.var.resize(task->variables.size());
+	for (unsigned int i = 0; i < task->variables.size(); i++) {
+		SASVariable &v = task->variables[i];
+		vector<unsigned int> values;
+		for (unsigned int j = 0; j < v.possibleValues.size(); j++)
+			values.push_back(p.value[v.possibleValues[j]]);
+		sort(values.begin(), values.end());
+		map< pair<string, vector<unsigned int> >, unsigned int>::iterator it =
+			varIndex.find(make_pair(!v.name.empty() && v.name[0] == '(' ? swapObjects(v.name, o1, o2) : "", values));
+		if (it == varIndex.end() || used[it->second]) return false;
+		used[it->second] = true;
+		p.var[i] = it->second;
+		if (it->second != i) changed = true;
+	}
+	used.assign(task->numVariables.size(), false);
+	p.numVar.resize(task->numVariables.size());
+	for (unsigned int i = 0; i < task->numVariables.size(); i++) {
+		unordered_map<string, unsigned int>::iterator it = numVarIndex.find(swapObjects(task->numVariables[i].name, o1, o2));
+		if (it == numVarIndex.end() || used[it->second]) return false;
+		used[it->second] = true;
+		p.numVar[i] = it->second;
+		if (it->second != i) changed = true;
+	}
+	return changed;
+}
+
+// Joins the orbits of the actions swapped by the permutation p of the objects o1 and o2. Nothing is joined if an
+// action is not mapped onto another one with the permuted conditions and effects
+void Memoization::joinActionOrbits(const string &o1, const string &o2, StatePermutation &p,
+	unordered_map<string, unsigned int> &actionIndex, vector<unsigned int> &actionOrbit) {
+	vector<unsigned int> image(task->actions.size());
+	for (unsigned int i = 0; i < task->actions.size(); i++) {
+		unordered_map<string, unsigned int>::iterator it = actionIndex.find(swapObjects(task->actions[i].name, o1, o2));
+		if (it == actionIndex.end() || !isPermutedAction(task->actions[i], task->actions[it->second], p)) return;
+		image[i] = it->second;
+	}
+	for (unsigned int i = 0; i < image.size(); i++) {
+		unsigned int r1 = findOrbit(actionOrbit, i), r2 = findOrbit(actionOrbit, image[i]);
+		if (r1 < r2) actionOrbit[r2] = r1;
+		else actionOrbit[r1] = r2;
+	}
+}
+
+// Checks if the action b is the action a after applying the permutation p. The numeric conditions and effects are
+// only compared by number, since the symmetric objects do not appear in the numeric constants
+bool Memoization::isPermutedAction(SASAction &a, SASAction &b, StatePermutation &p) {
+	return isPermutedList(a.startCond, b.startCond, p) && isPermutedList(a.overCond, b.overCond, p) &&
+		isPermutedList(a.endCond, b.endCond, p) && isPermutedList(a.startEff, b.startEff, p) &&
+		isPermutedList(a.endEff, b.endEff, p) && a.startNumCond.size() == b.startNumCond.size() &&
+		a.overNumCond.size() == b.overNumCond.size() && a.endNumCond.size() == b.endNumCond.size() &&
+		a.startNumEff.size() == b.startNumEff.size() && a.endNumEff.size() == b.endNumEff.size() &&
+		a.duration.size() == b.duration.size();
+}
+
+// Checks if the list of conditions (or effects) c2 is c1 after applying the permutation p
+bool Memoization::isPermutedList(vector<SASCondition> &c1, vector<SASCondition> &c2, StatePermutation &p) {
+	if (c1.size() != c2.size()) return false;
+	vector<TVarValue> v1, v2;
+	for (unsigned int i = 0; i < c1.size(); i++) {
+		unsigned int value = c1[i].value < p.value.size() ? p.value[c1[i].value] : c1[i].value;
+		v1.push_back(SASTask::getVariableValueCode(p.var[c1[i].var], value));
+		v2.push_back(SASTask::getVariableValueCode(c2[i].var, c2[i].value));
+	}
+	sort(v1.begin(), v1.end());
+	sort(v2.begin(), v2.end());
+	return v1 == v2;
+}
+
+// Applies the permutation p to the state s
+void Memoization::permute(TState* s, StatePermutation &p, TState* result) {
+	for (unsigned int i = 0; i < s->numSASVars; i++) {
+		TValue v = s->state[i];
+		result->state[p.var[i]] = v < p.value.size() ? p.value[v] : v;
+	}
+	for (unsigned int i = 0; i < s->numNumVars; i++)
+		result->numState[p.numVar[i]] = s->numState[i];
+}
+
+// Checks if s1 is lexicographically lower than s2
+bool Memoization::isLower(TState* s1, TState* s2) {
+	for (unsigned int i = 0; i < s1->numSASVars; i++)
+		if (s1->state[i] != s2->state[i]) return s1->state[i] < s2->state[i];
+	for (unsigned int i = 0; i < s1->numNumVars; i++)
+		if (s1->numState[i] != s2->numState[i]) return s1->numState[i] < s2->numState[i];
+	return false;
+}
+
+// Maps the state to a canonical representative of its symmetric states, applying the permutations while they
+// lower the state. The result is stored in buffer, or the state itself is returned if there are no symmetries
+TState* Memoization::canonicalize(TState* s, TState* buffer) {
+	if (permutations.empty()) return s;
+	buffer->copyValues(s);
+	bool lowered = true;
+	while (lowered) {
+		lowered = false;
+		for (unsigned int i = 0; i < permutations.size(); i++) {
+			permute(buffer, permutations[i], permutedState);
+			if (isLower(permutedState, buffer)) {
+				buffer->copyValues(permutedState);
+				lowered = true;
+			}
+		}
+	}
+	return buffer;
+}
+
+// Checks if the state, or a symmetric one, has already been reached
 bool Memoization::isRepeatedState(Plan* p, TState* state) {
+	state = canonicalize(state, canonicalState);
 	uint64_t code = state->getCode();
 	std::unordered_map<uint64_t, std::vector<Plan*>* >::const_iterator got = memo.find(code);
 	if (got == memo.end()) {	// New state
@@ -38,7 +250,7 @@ bool Memoization::isRepeatedState(Plan* p, TState* state) {
 		for (unsigned int i = 0; i < collisions->size(); i++) {
 			Plan* pc = collisions->at(i);
 			if (pc == nullptr) {
-				if (state->compareTo(initialState))
+				if (state->compareTo(canonicalInitialState))
 					return true;
 			} else if (sameState(state, pc)) {
 				if (p->gc >= pc->gc) return true;	// Same state and worse g
@@ -58,11 +270,11 @@ bool Memoization::sameState(TState* state, Plan* pc) {
 	linearizer.setCurrentPlan(nullptr);
 	TState* sc = linearizer.getFrontierState(task, nullptr);
 	if (sc == nullptr) return true;
-	bool equal = state->compareTo(sc);
-	delete sc;
-	return equal;
+	return state->compareTo(canonicalize(sc, canonicalFrontierState));
 }
 
 void Memoization::clear() {
+	for (std::unordered_map<uint64_t, std::vector<Plan*>* >::iterator it = memo.begin(); it != memo.end(); ++it)
+		delete it->second;
 	memo.clear();
 }
@@ -1,25 +1,54 @@
 #ifndef MEMOIZATION_H
 #define MEMOIZATION_H
 
+#include <map>
 #include <unordered_map>
 #include "plan.hpp"
 #include "linearizer.hpp"
 #include "../heuristics/state.hpp"
 
+class StatePermutation {	// Mapping of the SAS variables, values and numeric variables when two symmetric objects are swapped
+public:
+	std::vector<unsigned int> var;
+	std::vector<unsigned int> value;
+	std::vector<unsigned int> numVar;
+};
+
 class Memoization {
 private:
 	SASTask* task;
 	TState* initialState;
 	std::unordered_map<uint64_t, std::vector<Plan*>* > memo;
 	Linearizer linearizer;
+	std::vector<StatePermutation> permutations;		// One for each pair of symmetric objects
+	TState* canonicalInitialState;
+	TState* canonicalState;
+	TState* canonicalFrontierState;
+	TState* permutedState;
+	std::vector<bool> symmetricAction;				// Actions symmetric to another one with a lower index
 
 	bool sameState(TState* state, Plan* pc);
+	void computePermutations();
+	bool computePermutation(const std::string &o1, const std::string &o2, std::unordered_map<std::string, unsigned int> &valueIndex,
+		std::map< std::pair<std::string, std::vector<unsigned int> >, unsigned int> &varIndex,
+		std::unordered_map<std::string, unsigned int> &numVarIndex, StatePermutation &p);
+	void joinActionOrbits(const std::string &o1, const std::string &o2, StatePermutation &p,
+		std::unordered_map<std::string, unsigned int> &actionIndex, std::vector<unsigned int> &actionOrbit);
+	bool isPermutedAction(SASAction &a, SASAction &b, StatePermutation &p);
+	bool isPermutedList(std::vector<SASCondition> &c1, std::vector<SASCondition> &c2, StatePermutation &p);
+	void permute(TState* s, StatePermutation &p, TState* result);
+	bool isLower(TState* s1, TState* s2);
+	TState* canonicalize(TState* s, TState* buffer);
 
 public:
 	Memoization();
+	~Memoization();
 	void initialize(SASTask* task);
 	bool isRepeatedState(Plan* p, TState* state);
 	void clear();
+	inline bool isSymmetricAction(unsigned int action) {
+		return action < symmetricAction.size() && symmetricAction[action];
+	}
 };
 
 #endif
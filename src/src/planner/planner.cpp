@@ -35,7 +35,7 @@ Planner::Planner(SASTask* task, Plan* initialPlan, TState* initialState, bool fo
 }
 
 Planner::~Planner() {
-
+	delete successors;
 }
 
 bool Planner::timeExceed() {
@@ -69,30 +69,6 @@ std::string Planner::planToPDDL(Plan* p) {
 	return linearizer.planToPDDL(p, task);
 }
 
-Plan* Planner::createInitialPlan(TState* s) {
-	SASAction* a = new SASAction();
-	a->index = MAX_UNSIGNED_INT;
-	a->name = "#initial";
-	SASDuration duration;
-	duration.time = 'N';
-	duration.comp = '=';
-	duration.exp.type = 'N';	// Number (epsilon duration)
-	duration.exp.value = 0;
-	a->duration.push_back(duration);
-	for (unsigned int varIndex = 0; varIndex < s->numSASVars; varIndex++) {
-		a->endEff.emplace_back(varIndex, s->state[varIndex]);
-	}
-	for (unsigned int varIndex = 0; varIndex < s->numNumVars; varIndex++) {
-		SASNumericEffect eff;
-		eff.op = '=';
-		eff.var = varIndex;
-		eff.exp.type = 'N';				// Number
-		eff.exp.value = s->numState[varIndex];
-		a->endNumEff.push_back(eff);
-	}
-	return new Plan(a, nullptr, 0);
-}
-
 Plan* Planner::improveSolution(uint16_t bestG, float bestGC, bool first) {
 	if (first) {
 		//successors->clear();
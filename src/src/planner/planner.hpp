@@ -44,7 +44,6 @@ protected:
 	clock_t startTime;
 
 	void writeTrace(std::ofstream& f, Plan* p);
-	Plan* createInitialPlan(TState* s);
 	void addFrontierNodes(Plan* p);
 	void calculateDeadlines();
 	void updateState(TState* state, SASAction* a);
@@ -63,11 +63,15 @@ std::string PlannerSetting::planToPDDL(Plan* p) {
 	return planner->planToPDDL(p);
 }
 
-// Creates the initial empty plan that only contains the initial and the TIL fictitious actions
+// Creates the initial empty plan that only contains the initial and the TIL fictitious actions. The fictitious
+// actions are compiled here, once, and shared by the planners
 void PlannerSetting::createInitialPlan() {
 	SASAction* initialAction = createInitialAction();
+	task->compileAction(initialAction);
 	initialPlan = new Plan(initialAction, nullptr, 0);
 	initialPlan = createTILactions(initialPlan);
+	for (unsigned int i = 0; i < tilActions.size(); i++)
+		task->compileAction(tilActions[i]);
 }
 
 // Creates and returns the initial fictitious action
@@ -133,6 +137,7 @@ SASAction* PlannerSetting::createFictitiousAction(float actionDuration, vector<u
 			}
 		}
 	}
+	a->computeNumericVariableSets();
 	return a;
 }
 
@@ -200,7 +205,7 @@ bool PlannerSetting::checkRepeatedStates() {
 			for (unsigned int j = 0; j < a.endEff.size(); j++) {
 				if (a.endEff[j].var == v && a.endEff[j].value != value) {
 					// If (v = value) is required by any action, the domain is concurrent
-					vector<SASAction*> &req = task->requirers[v][value];
+					SASActionList req = task->getRequirers(v, value);
 					for (unsigned int k = 0; k < req.size(); k++) {
 						if (req[k] != &a) {
 							return false;
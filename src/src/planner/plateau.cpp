@@ -50,7 +50,6 @@ void Plateau::calculatePriorityGoals() {
 	std::vector<uint16_t> hValue(goals->size(), 0);
 	TState* state = successors->getFrontierState(initialPlan);
 	RPG rpg(state, task, successors->getForceAtEndConditions(), successors->getTILActions());
-	delete state;
 	for (unsigned int i = 0; i < goals->size(); i++) {
 		hValue[i] = rpg.evaluate(goals->at(i), false);
 		//cout << task->values[SASTask::getValueIndex(goals->at(i))].name << ", h = " << hValue[i] << endl;
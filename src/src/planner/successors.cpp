@@ -10,6 +10,7 @@
 #include <iostream>
 #include <time.h>
 #include <cassert>
+#include <algorithm>
 #include "successors.hpp"
 #include "../utils/utils.hpp"
 #include "../heuristics/hFF.hpp"
@@ -19,12 +20,17 @@ using namespace std;
 /* CLASS: PlanEffect                                    */
 /********************************************************/
 
-void PlanEffect::add(TTimePoint time, unsigned int iteration) {
+void PlanEffect::add(TTimePoint time, unsigned int iteration, TimePointPool* pool) {
+	unsigned int pos = pool->timePoints.size();
+	pool->timePoints.push_back(time);
+	pool->next.push_back(MAX_UNSIGNED_INT);
 	if (this->iteration != iteration) {		// Delete data from previous iterations
-		timePoints.clear();
+		first = pos;
 		this->iteration = iteration;
+	} else {
+		pool->next[last] = pos;
 	}
-	timePoints.push_back(time);
+	last = pos;
 }
 
 
@@ -42,6 +48,20 @@ void VarChange::add(TValue v, TTimePoint time, unsigned int iteration) {
 	timePoints.push_back(time);
 }
 
+/********************************************************/
+/* CLASS: VarCausalLinks                                */
+/********************************************************/
+
+void VarCausalLinks::add(CausalLink* cl, unsigned int pos, unsigned int iteration) {
+	if (this->iteration != iteration) {		// Delete data from previous iterations
+		links.clear();
+		position.clear();
+		this->iteration = iteration;
+	}
+	links.push_back(cl);
+	position.push_back(pos);
+}
+
 /********************************************************/
 /* CLASS: Threat                                        */
 /********************************************************/
@@ -163,13 +183,12 @@ void Successors::initialize(TState* state, SASTask* task, bool forceAtEndConditi
 	this->forceAtEndConditions = forceAtEndConditions;
 	this->filterRepeatedStates = filterRepeatedStates;
 	linearizer.setInitialState(state, task);
+	frontierState = new TState(state);
 	numVariables = task->variables.size();
 	numActions = task->actions.size();
-	planEffects = new PlanEffect*[numVariables];
-	for (unsigned int i = 0; i < numVariables; i++) {
-		planEffects[i] = new PlanEffect[task->values.size()];
-	}
+	computePlanEffectRows();
 	varChanges = new VarChange[numVariables];
+	varCausalLinks = new VarCausalLinks[numVariables];
 	idPlan = 0;
 	solution = nullptr;
 	evaluator.initialize(state, task, tilActions, forceAtEndConditions);
@@ -183,15 +202,100 @@ void Successors::initialize(TState* state, SASTask* task, bool forceAtEndConditi
 		checkedAction.push_back(0);
 	}
 	currentIteration = 0;
+	computeConditionIndex();
 }
 
-// Destructor
-Successors::~Successors() {
+// Updates the range of values of a variable
+static inline void updateValueRange(unsigned int value, unsigned int &minValue, unsigned int &maxValue) {
+	if (value < SHARED_VALUES) return;
+	if (value < minValue) minValue = value;
+	if (value > maxValue) maxValue = value;
+}
+
+// Updates the range of values of the variables with the conditions and effects of an action
+static void updateValueRange(SASAction* a, unsigned int* minValue, unsigned int* maxValue) {
+	for (SASCondition &c : a->startCond) updateValueRange(c.value, minValue[c.var], maxValue[c.var]);
+	for (SASCondition &c : a->overCond)  updateValueRange(c.value, minValue[c.var], maxValue[c.var]);
+	for (SASCondition &c : a->endCond)   updateValueRange(c.value, minValue[c.var], maxValue[c.var]);
+	for (SASCondition &c : a->startEff)  updateValueRange(c.value, minValue[c.var], maxValue[c.var]);
+	for (SASCondition &c : a->endEff)    updateValueRange(c.value, minValue[c.var], maxValue[c.var]);
+}
+
+// Allocates the plan effects. Instead of a row of task->values.size() elements, each variable only
+// has room for the shared values and for the range of values it can take
+void Successors::computePlanEffectRows() {
+	unsigned int* minValue = new unsigned int[numVariables];
+	unsigned int* maxValue = new unsigned int[numVariables];
 	for (unsigned int i = 0; i < numVariables; i++) {
-	    delete[] planEffects[i];
+		minValue[i] = MAX_UNSIGNED_INT;
+		maxValue[i] = 0;
+		SASVariable &v = task->variables[i];
+		for (unsigned int j = 0; j < v.possibleValues.size(); j++)
+			updateValueRange(v.possibleValues[j], minValue[i], maxValue[i]);
+		for (unsigned int j = 0; j < v.value.size(); j++)
+			updateValueRange(v.value[j], minValue[i], maxValue[i]);
+	}
+	for (unsigned int i = 0; i < task->actions.size(); i++)
+		updateValueRange(&(task->actions[i]), minValue, maxValue);
+	for (unsigned int i = 0; i < task->goals.size(); i++)
+		updateValueRange(&(task->goals[i]), minValue, maxValue);
+	std::vector<GoalDeadline>* deadlines = task->getGoalDeadlines();
+	for (unsigned int i = 0; i < deadlines->size(); i++) {
+		for (TVarValue goal : deadlines->at(i).goals) {
+			TVariable v = SASTask::getVariableIndex(goal);
+			updateValueRange(SASTask::getValueIndex(goal), minValue[v], maxValue[v]);
+		}
 	}
+	effectRow = new unsigned int[numVariables];
+	firstRowValue = new unsigned int[numVariables];
+	unsigned int size = 0;
+	for (unsigned int i = 0; i < numVariables; i++) {
+		effectRow[i] = size;
+		size += SHARED_VALUES;
+		if (minValue[i] <= maxValue[i]) {
+			firstRowValue[i] = minValue[i];
+			size += maxValue[i] - minValue[i] + 1;
+		} else firstRowValue[i] = SHARED_VALUES;
+	}
+	planEffects = new PlanEffect[size];
+	delete[] minValue;
+	delete[] maxValue;
+}
+
+// Indexes the actions by their non-numeric conditions, so the actions supported by the root plan
+// can be enumerated without checking all of them
+void Successors::computeConditionIndex() {
+	vector<TVarValue> cond;
+	numConditions.resize(numActions);
+	numSupportedConditions.resize(numActions, 0);
+	for (unsigned int i = 0; i < numActions; i++) {
+		SASAction* a = &(task->actions[i]);
+		cond.clear();
+		for (unsigned int j = 0; j < a->startCond.size(); j++)
+			cond.push_back(SASTask::getVariableValueCode(a->startCond[j].var, a->startCond[j].value));
+		for (unsigned int j = 0; j < a->overCond.size(); j++)
+			cond.push_back(SASTask::getVariableValueCode(a->overCond[j].var, a->overCond[j].value));
+		if (forceAtEndConditions) {
+			for (unsigned int j = 0; j < a->endCond.size(); j++)
+				cond.push_back(SASTask::getVariableValueCode(a->endCond[j].var, a->endCond[j].value));
+		}
+		sort(cond.begin(), cond.end());
+		cond.erase(unique(cond.begin(), cond.end()), cond.end());
+		numConditions[i] = cond.size();
+		if (cond.empty()) unconditionedActions.push_back(i);
+		for (unsigned int j = 0; j < cond.size(); j++)
+			conditionIndex[cond[j]].push_back(i);
+	}
+}
+
+// Destructor
+Successors::~Successors() {
 	delete[] planEffects;
+	delete[] effectRow;
+	delete[] firstRowValue;
 	delete[] varChanges;
+	delete[] varCausalLinks;
+	delete frontierState;
 }
 
 // Fills vector suc with the possible successor plans of the given base plan
@@ -214,13 +318,7 @@ void Successors::computeSuccessors(Plan* base, vector<Plan*>* suc) {
 	if (solution != nullptr) return;
 	currentIteration++;
 	if (base->isRoot()) {	// Full calculation of successors
-		for (unsigned int i = 0; i < task->goals.size(); i++) {
-			fullActionCheck(&(task->goals[i]));
-		}
-		for (unsigned int i = 0; i < task->actions.size(); i++) {
-			//cout << "Action " << i << endl;
-			fullActionCheck(&(task->actions[i]));
-		}
+		computeRootSuccessors();
 	} else { 							// Calculation of successores based on the parent plan
 		computeSuccessorsSupportedByLastActions();
 		computeSuccessorsThroughBrotherPlans();
@@ -239,7 +337,7 @@ bool Successors::meetDeadlines() {
 				TVarValue goal = deadline.goals[j];
 				TVariable v = SASTask::getVariableIndex(goal);
 				TValue value = SASTask::getValueIndex(goal);
-				if (planEffects[v][value].iteration != linearizer.getIteration()) {
+				if (getPlanEffect(v, value).iteration != linearizer.getIteration()) {
 					cout << "-";
 					return false;
 				}
@@ -269,17 +367,17 @@ void Successors::computeSuccessorsConcurrent(Plan* base, vector<Plan*>* suc) {
 	suc->clear();
 	computeSuccessorsSupportedByLastActions();
 	computeSuccessorsThroughBrotherPlans();
-	TState* s = linearizer.getFrontierState(task, nullptr);
+	TState* s = frontierState;	// The linearizer state is overwritten when the successors are checked
+	s->copyValues(linearizer.getFrontierState(task, nullptr));
 	for (unsigned int i = 0; i < s->numSASVars; i++) {
-		vector<SASAction*> &req = task->requirers[i][s->state[i]];
+		SASActionList req = task->getRequirers(i, s->state[i]);
 		for (unsigned int j = 0; j < req.size(); j++) {
-			if (!visitedAction(req[j]) && s->isExecutable(req[j])) {
+			if (!visitedAction(req[j]) && s->isExecutable(req[j], &(task->actionTable))) {
 				fullActionCheck(req[j]);
 			}
 		}
 
 	}
-	delete s;
 	/*SASAction* a;
 	unsigned int numActions = task->actions.size();
 	for (unsigned int i = 0; i < numActions; i++) {
@@ -291,7 +389,7 @@ void Successors::computeSuccessorsConcurrent(Plan* base, vector<Plan*>* suc) {
 		basePlanState = linearizer.linearize(newStep, newStep << 1, task, nullptr);
 		for (unsigned int i = 0; i < numActions; i++) {
 			a = &(task->actions[i]);
-			if (basePlanState->isExecutable(a)) {
+			if (basePlanState->isExecutable(a, &(task->actionTable))) {
 				fullActionCheck(a);
 			}
 		}
@@ -309,7 +407,7 @@ void Successors::computeSuccessorsConcurrent(Plan* base, vector<Plan*>* suc) {
 		for (unsigned int i = 0; i < a->startEff.size(); i++) {
 			var = a->startEff[i].var;
 			v = a->startEff[i].value;
-			vector<SASAction*> &req = task->requirers[var][v];
+			SASActionList req = task->getRequirers(var, v);
 			for (unsigned int j = 0; j < req.size(); j++) {
 				if (!visitedActions[req[j]->index]) {
 					visitedActions[req[j]->index] = true;
@@ -320,7 +418,7 @@ void Successors::computeSuccessorsConcurrent(Plan* base, vector<Plan*>* suc) {
 		for (unsigned int i = 0; i < a->endEff.size(); i++) {
 			var = a->endEff[i].var;
 			v = a->endEff[i].value;
-			vector<SASAction*> &req = task->requirers[var][v];
+			SASActionList req = task->getRequirers(var, v);
 			for (unsigned int j = 0; j < req.size(); j++) {
 				if (!visitedActions[req[j]->index]) {
 					visitedActions[req[j]->index] = true;
@@ -337,23 +435,72 @@ void Successors::computeSuccessorsConcurrent(Plan* base, vector<Plan*>* suc) {
 void Successors::computeBasePlanEffects() {
 	unsigned int var, value;
 	TTimePoint time;
+	timePointPool.clear();
 	for (unsigned int i = 0; i < linearizer.numComponents(); i++) {
 		SASAction* a = linearizer.getComponent(i)->action;
 		for (unsigned int j = 0; j < a->startEff.size(); j++) {
 			var = a->startEff[j].var;
 			value = a->startEff[j].value;
 			time = stepToStartPoint(i);
-			planEffects[var][value].add(time, linearizer.getIteration());
+			getPlanEffect(var, value).add(time, linearizer.getIteration(), &timePointPool);
 			varChanges[var].add(value, time, linearizer.getIteration());
 		}
 		for (unsigned int j = 0; j < a->endEff.size(); j++) {
 			var = a->endEff[j].var;
 			value = a->endEff[j].value;
 			time = stepToEndPoint(i);
-			planEffects[var][value].add(time, linearizer.getIteration());
+			getPlanEffect(var, value).add(time, linearizer.getIteration(), &timePointPool);
 			varChanges[var].add(value, time, linearizer.getIteration());
 		}
 	}
+	unsigned int pos = 0;
+	for (unsigned int i = 1; i < linearizer.numComponents(); i++) {	// Causal links of the base plan, indexed by variable
+		vector<CausalLink> &causalLinks = linearizer.getComponent(i)->causalLinks;
+		for (unsigned int j = 0; j < causalLinks.size(); j++) {
+			varCausalLinks[causalLinks[j].getVar()].add(&(causalLinks[j]), pos++, linearizer.getIteration());
+		}
+	}
+}
+
+// Checks all the goals and the actions whose conditions are supported by the effects of the root plan.
+// The actions are checked in the same order as in task->actions
+void Successors::computeRootSuccessors() {
+	for (unsigned int i = 0; i < task->goals.size(); i++) {
+		fullActionCheck(&(task->goals[i]));
+	}
+	rootCandidates = unconditionedActions;
+	unsigned int prevCandidates = rootCandidates.size();
+	vector<const vector<unsigned int>*> supportedReq;
+	for (unsigned int var = 0; var < numVariables; var++) {
+		VarChange &vc = varChanges[var];
+		if (!linearizer.checkIteration(vc.iteration)) continue;
+		for (unsigned int i = 0; i < vc.values.size(); i++) {
+			TValue value = vc.values[i];
+			if (timePointPool.timePoints[getPlanEffect(var, value).first] != vc.timePoints[i]) continue;	// Value already counted
+			unordered_map<TVarValue, vector<unsigned int>>::const_iterator it = conditionIndex.find(SASTask::getVariableValueCode(var, value));
+			if (it == conditionIndex.end()) continue;
+			const vector<unsigned int> &req = it->second;
+			for (unsigned int j = 0; j < req.size(); j++) {
+				if (++numSupportedConditions[req[j]] == numConditions[req[j]])
+					rootCandidates.push_back(req[j]);
+			}
+			supportedReq.push_back(&req);
+		}
+	}
+	for (unsigned int i = 0; i < supportedReq.size(); i++) {		// Reset the counters
+		for (unsigned int j = 0; j < supportedReq[i]->size(); j++)
+			numSupportedConditions[(*supportedReq[i])[j]] = 0;
+	}
+	if (rootCandidates.size() > prevCandidates)
+		sort(rootCandidates.begin(), rootCandidates.end());
+	symmetricRootActions.clear();
+	for (unsigned int i = 0; i < rootCandidates.size(); i++) {
+		if (memoization.isSymmetricAction(rootCandidates[i])) {	// The root plan is symmetric, so is the successor
+			symmetricRootActions.push_back(rootCandidates[i]);
+			continue;
+		}
+		fullActionCheck(&(task->actions[rootCandidates[i]]));
+	}
 }
 
 // Checks if the given action can generate a successor plan
@@ -388,10 +535,10 @@ void Successors::fullActionSupportCheck(PlanBuilder* pb) {
 void Successors::fullCondtionSupportCheck(PlanBuilder* pb, SASCondition* c, TTimePoint condPoint, bool overAll, bool canLeaveOpen) {
 	//cout << "Checking condition " << task->variables[c->var].name << "," << task->values[c->value].name << " for action " << pb->action->name << endl;
 	bool supportFound = false;
-	if (linearizer.checkIteration(planEffects[c->var][c->value].iteration)) {
-		vector<TTimePoint>* supports = &(planEffects[c->var][c->value].timePoints);
-		for (unsigned int i = 0; i < supports->size(); i++) {
-			TTimePoint p = (*supports)[i];
+	PlanEffect &effect = getPlanEffect(c->var, c->value);
+	if (linearizer.checkIteration(effect.iteration)) {
+		for (unsigned int i = effect.first; i != MAX_UNSIGNED_INT; i = timePointPool.next[i]) {
+			TTimePoint p = timePointPool.timePoints[i];
 			//cout << "+ CL: " << p << " ---> " << condPoint << " (" << task->variables[c->var].name << "," << task->values[c->value].name << ")" << endl;
 			if (pb->addLink(c, p, condPoint)) {				// Causal link added: p --- (c->var = c->value) ----> condPoint
 				if (overAll) pb->addLink(c, p, condPoint + 1);
@@ -569,43 +716,52 @@ void Successors::checkTheatsBetweenCausalLinkInBasePlanWithNewAction(PlanBuilder
 	TTimePoint pc = pb->lastTimePoint - 1;
 	vector<SASCondition> &startEff = pb->action->startEff;
 	vector<SASCondition> &endEff = pb->action->endEff;
-	unsigned int numCausalLinks;
 	TTimePoint p1, p2;
 	TVariable var;
 	TValue v;
-	for (unsigned p = 1; p < linearizer.numComponents(); p++) {	// Threats between the causal links in the base plan and the effects of the new action
-		numCausalLinks = linearizer.getComponent(p)->causalLinks.size();
-		for (unsigned int i = 0; i < numCausalLinks; i++) {
-			CausalLink &cl = linearizer.getComponent(p)->causalLinks[i];
-			p1 = cl.firstPoint();
-			p2 = cl.secondPoint();
-			if (!linearizer.existOrder(pc, p1) && !linearizer.existOrder(p2, pc)) {
-				var = cl.getVar();
-				v = cl.getValue();
+	threatenedLinks.clear();		// Causal links in the base plan on the variables modified by the new action
+	for (unsigned int i = 0; i < startEff.size() + endEff.size(); i++) {
+		var = i < startEff.size() ? startEff[i].var : endEff[i - startEff.size()].var;
+		VarCausalLinks &vcl = varCausalLinks[var];
+		if (!linearizer.checkIteration(vcl.iteration)) continue;
+		bool repeatedVar = false;
+		for (unsigned int j = 0; j < i && !repeatedVar; j++)
+			repeatedVar = var == (j < startEff.size() ? startEff[j].var : endEff[j - startEff.size()].var);
+		if (repeatedVar) continue;
+		for (unsigned int j = 0; j < vcl.links.size(); j++)
+			threatenedLinks.emplace_back(vcl.position[j], vcl.links[j]);
+	}
+	sort(threatenedLinks.begin(), threatenedLinks.end());	// Same order as in the base plan
+	for (unsigned int i = 0; i < threatenedLinks.size(); i++) {	// Threats between the causal links in the base plan and the effects of the new action
+		CausalLink &cl = *(threatenedLinks[i].second);
+		p1 = cl.firstPoint();
+		p2 = cl.secondPoint();
+		if (!linearizer.existOrder(pc, p1) && !linearizer.existOrder(p2, pc)) {
+			var = cl.getVar();
+			v = cl.getValue();
 #ifdef DEBUG_SUCC_ON
-				cout << " - Threat : " << p1 << " -- " << task->variables[var].name << "," << task->values[v].name << " --> "  << p2 << endl;
+			cout << " - Threat : " << p1 << " -- " << task->variables[var].name << "," << task->values[v].name << " --> "  << p2 << endl;
 #endif
-				for (unsigned int j = 0; j < startEff.size(); j++) {
-					if (startEff[j].var == var && startEff[j].value != v) {
-						threats.emplace_back(p1, p2, pc, var);
+			for (unsigned int j = 0; j < startEff.size(); j++) {
+				if (startEff[j].var == var && startEff[j].value != v) {
+					threats.emplace_back(p1, p2, pc, var);
 #ifdef DEBUG_SUCC_ON
-						cout << "   Threat found" << endl;
+					cout << "   Threat found" << endl;
 #endif
-						break;
-					}
+					break;
 				}
-				pc++;
-				for (unsigned int j = 0; j < endEff.size(); j++) {
-					if (endEff[j].var == var && endEff[j].value != v) {
-						threats.emplace_back(p1, p2, pc, var);
+			}
+			pc++;
+			for (unsigned int j = 0; j < endEff.size(); j++) {
+				if (endEff[j].var == var && endEff[j].value != v) {
+					threats.emplace_back(p1, p2, pc, var);
 #ifdef DEBUG_SUCC_ON
-						cout << "   Threat found" << endl;
+					cout << "   Threat found" << endl;
 #endif
-						break;
-					}
+					break;
 				}
-				pc--;
 			}
+			pc--;
 		}
 	}
 	for (unsigned int i = 0; i < pb->causalLinks.size(); i++) {	// Threats between the new causal links and the actions in the base plan
@@ -658,7 +814,7 @@ void Successors::computeSuccessorsSupportedByLastActions() {
 		for (unsigned int i = 0; i < a->startEff.size(); i++) {
 			var = a->startEff[i].var;
 			v = a->startEff[i].value;
-			vector<SASAction*> &req = task->requirers[var][v];
+			SASActionList req = task->getRequirers(var, v);
 			for (unsigned int j = 0; j < req.size(); j++) {
 				if (!visitedAction(req[j])) {
 					setVisitedAction(req[j]);
@@ -675,7 +831,7 @@ void Successors::computeSuccessorsSupportedByLastActions() {
 		for (unsigned int i = 0; i < a->endEff.size(); i++) {
 			var = a->endEff[i].var;
 			v = a->endEff[i].value;
-			vector<SASAction*> &req = task->requirers[var][v];
+			SASActionList req = task->getRequirers(var, v);
 			for (unsigned int j = 0; j < req.size(); j++) {
 				if (!visitedAction(req[j])) {
 					setVisitedAction(req[j]);
@@ -705,6 +861,15 @@ void Successors::computeSuccessorsThroughBrotherPlans() {
 			fullActionSupportCheck(&pb);
 		}
 	}
+	if (parentPlan->isRoot()) {		// The symmetric root successors were not generated, but they are still brothers
+		for (unsigned int i = 0; i < symmetricRootActions.size(); i++) {
+			SASAction* a = &(task->actions[symmetricRootActions[i]]);
+			if (!visitedAction(a)) {
+				setVisitedAction(a);
+				fullActionCheck(a);
+			}
+		}
+	}
 }
 
 void Successors::computeSolutionSuccessors() {
@@ -848,7 +1013,6 @@ void Successors::printState(Plan* p) {
 	for (unsigned int i = 0; i < state->numNumVars; i++) {
 		cout << task->numVariables[i].name << "=" << state->numState[i] << endl;
 	}
-	delete state;
 }
 
 // Linearizes the plan, check numeric/duration constraints and evaluates the plan
@@ -858,7 +1022,6 @@ bool Successors::postprocessPlan(Plan* p) {
 	if (state != nullptr) {
 		if (p->isSolution()) {
 			if (!goalsSupported(state)) {
-				delete state;
 				return false;
 			}
 		}
@@ -866,7 +1029,6 @@ bool Successors::postprocessPlan(Plan* p) {
 		evaluator.evaluate(p, state, linearizer.makespan, helpfulActions);
 		p->repeatedState = filterRepeatedStates ? memoization.isRepeatedState(p, state) : false;
 		//p->checkUsefulPlan();
-		delete state;
 		return true;
 	}
 	else {
@@ -884,7 +1046,6 @@ void Successors::evaluate(Plan* p) {
 	TState* state = linearizer.getFrontierState(task, evaluator.getLandmarkHeuristic());
 	p->gc = task->evaluateMetric(state->numState, linearizer.makespan);
 	evaluator.evaluate(p, state, linearizer.makespan, helpfulActions);
-	delete state;
 }
 
 bool Successors::goalsSupported(TState* s) {
@@ -896,18 +1057,8 @@ bool Successors::goalsSupported(TState* s) {
 }
 
 bool Successors::actionSupported(SASAction* a, TState* s) {
-	for (unsigned int i = 0; i < a->startCond.size(); i++) {
-		if (s->state[a->startCond[i].var] != a->startCond[i].value)
-			return false;
-	}
-	for (unsigned int i = 0; i < a->overCond.size(); i++) {
-		if (s->state[a->overCond[i].var] != a->overCond[i].value)
-			return false;
-	}
-	for (unsigned int i = 0; i < a->endCond.size(); i++) {
-		if (s->state[a->endCond[i].var] != a->endCond[i].value)
-			return false;
-	}
+	if (!s->isExecutable(a, &(task->actionTable)))
+		return false;
 	for (unsigned int i = 0; i < a->startNumCond.size(); i++) {
 		if (!task->holdsNumericCondition(a->startNumCond[i], s->numState, EPSILON))
 			return false;
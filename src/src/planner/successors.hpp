@@ -9,13 +9,23 @@
 #define INITAL_MATRIX_SIZE	400
 #define MATRIX_INCREASE		200
 
+class TimePointPool {
+public:
+	std::vector<TTimePoint> timePoints;	// Points of time where the effects are produced
+	std::vector<unsigned int> next;		// Position of the next point of time of the same effect (MAX_UNSIGNED_INT if it is the last one)
+
+	inline void clear() { timePoints.clear(); next.clear(); }
+};
+
 class PlanEffect {	
 public:
-	std::vector<TTimePoint> timePoints;	// Points of time where this effect is produced
+	unsigned int first;					// Position in the pool of the first point of time where this effect is produced
 										// Dividing the time point by 2 we get the number of the step in the plan (each step has two time points: start and end)
+	unsigned int last;					// Position in the pool of the last point of time where this effect is produced
 	unsigned int iteration;				// The information is valid only if the iteration matches with the current one
 
-	void add(TTimePoint time, unsigned int iteration);
+	PlanEffect() : first(MAX_UNSIGNED_INT), last(MAX_UNSIGNED_INT), iteration(0) {}
+	void add(TTimePoint time, unsigned int iteration, TimePointPool* pool);
 };
 
 class VarChange {
@@ -27,6 +37,16 @@ public:
 	void add(TValue v, TTimePoint time, unsigned int iteration);
 };
 
+class VarCausalLinks {
+public:
+	std::vector<CausalLink*> links;		// Causal links of the base plan on this variable
+	std::vector<unsigned int> position;	// Position of each causal link in the base plan
+	unsigned int iteration;				// The information is valid only if the iteration matches with the current one
+
+	VarCausalLinks() : iteration(0) {}
+	void add(CausalLink* cl, unsigned int pos, unsigned int iteration);
+};
+
 class Threat {
 public:
 	TTimePoint p1;
@@ -70,14 +90,20 @@ private:
 	unsigned int numVariables;							// Number of variables
 	unsigned int numActions;							// Number of grounded actions
 	Plan* basePlan;										// Base plan
-	PlanEffect** planEffects;							// Plan effects: (var, value) -> PlanEffect
+	PlanEffect* planEffects;							// Plan effects: (var, value) -> PlanEffect. One row per variable, sized to its range of values
+	unsigned int* effectRow;							// Position in planEffects of the row of each variable
+	unsigned int* firstRowValue;						// Lowest non-shared value in the row of each variable
+	TimePointPool timePointPool;						// Points of time of the plan effects
 	VarChange* varChanges;								// Variable changes: var -> VarChange
+	VarCausalLinks* varCausalLinks;						// Causal links in the base plan: var -> VarCausalLinks
+	std::vector<std::pair<unsigned int, CausalLink*>> threatenedLinks;	// For internal calculations
 	TStep newStep;										// New step to add as successor
 	std::vector<Plan*>* successors;						// Vector to return the sucessor plans
 	std::vector<TTimePoint> prevPoints;					// For internal calculations
 	std::vector<TTimePoint> nextPoints;					// For internal calculations
 	uint32_t idPlan;									// Plan counter
 	Linearizer linearizer;								// Linearizes plans to schedule them in time and compute heuristics
+	TState* frontierState;								// Frontier state of the base plan
 	Evaluator evaluator;
 	//TState* basePlanState;
 	Memoization memoization;
@@ -85,29 +111,34 @@ private:
 	std::vector<unsigned int> checkedAction;
 	unsigned int currentIteration;
 	bool helpfulActions;
+	std::unordered_map<TVarValue, std::vector<unsigned int>> conditionIndex;	// (var, value) -> actions that require it (at-start and over-all conditions, and at-end ones if they are forced)
+	std::vector<unsigned int> numConditions;			// Number of different (var, value) conditions of each action in conditionIndex
+	std::vector<unsigned int> numSupportedConditions;	// For internal calculations: conditions of each action supported by the base plan
+	std::vector<unsigned int> unconditionedActions;		// Actions with no conditions in conditionIndex
+	std::vector<unsigned int> rootCandidates;			// For internal calculations: actions supported by the root plan
+	std::vector<unsigned int> symmetricRootActions;		// Root candidates skipped because they are symmetric to another one
 
 	inline bool visitedAction(SASAction* a) { return checkedAction[a->index] == currentIteration; }
 	inline void setVisitedAction(SASAction* a) { checkedAction[a->index] = currentIteration; }
+	void computePlanEffectRows();
+	inline PlanEffect& getPlanEffect(unsigned int var, unsigned int value) {
+		return planEffects[effectRow[var] + (value < SHARED_VALUES ? value : value - firstRowValue[var] + SHARED_VALUES)];
+	}
 	void computeBasePlanEffects();						// Fill the planEffects matrix with the effects produced by the base plan
+	void computeConditionIndex();
+	void computeRootSuccessors();
 	void fullActionCheck(SASAction* a);
 	void fullActionSupportCheck(PlanBuilder* pb);
 	inline bool supportedAction(const SASAction* a) {
-		for (unsigned int i = 0; i < a->startCond.size(); i++)
-			if (!supportedCondition(a->startCond[i]))
-				return false;
-		for (unsigned int i = 0; i < a->overCond.size(); i++) {
-			if (!supportedCondition(a->overCond[i]))
+		SASActionTable* table = &(task->actionTable);
+		unsigned int last = table->end(a->tableRow, forceAtEndConditions ? SASActionTable::END_COND : SASActionTable::OVER_COND);
+		for (unsigned int i = table->begin(a->tableRow, SASActionTable::START_COND); i < last; i++)
+			if (!supportedCondition(table->facts[i]))
 				return false;
-		}
-		if (forceAtEndConditions) {
-			for (unsigned int i = 0; i < a->endCond.size(); i++)
-				if (!supportedCondition(a->endCond[i]))
-					return false;
-		}
 		return true;
 	}
-	inline bool supportedCondition(const SASCondition &c) {
-		return planEffects[c.var][c.value].iteration == linearizer.getIteration();
+	inline bool supportedCondition(const SASFact &c) {
+		return getPlanEffect(c.var, c.value).iteration == linearizer.getIteration();
 	}
 	void fullCondtionSupportCheck(PlanBuilder* pb, SASCondition* c, TTimePoint condPoint, bool overAll, bool canLeaveOpen);
 	void generateSuccessor(PlanBuilder* pb);
@@ -122,20 +153,25 @@ private:
 	void addSuccessor(Plan* p);
 	void solveBasePlanOpenConditionIfPossible(unsigned int condNumber, PlanBuilder* pb);
 	bool mutexPoints(TTimePoint p1, TTimePoint p2, TVariable var, PlanBuilder* pb);
+	inline int findFact(SASAction* a, unsigned int section, TVariable var) {	// Position of the variable in the given section, or -1
+		SASActionTable* table = &(task->actionTable);
+		unsigned int first = table->begin(a->tableRow, section), last = table->end(a->tableRow, section);
+		for (unsigned int i = first; i < last; i++)
+			if (table->facts[i].var == var) return i - first;
+		return -1;
+	}
 	inline SASCondition* getRequiredValue(TTimePoint p, SASAction* a, TVariable var) {
-		std::vector<SASCondition>* cond = (p & 1) == 0 ? &(a->startCond) : &(a->endCond);
-		for (unsigned int i = 0; i < cond->size(); i++)
-			if ((*cond)[i].var == var) return &((*cond)[i]);
-		cond = &(a->overCond);	// Check over-all conditions then
-		for (unsigned int i = 0; i < cond->size(); i++)
-			if ((*cond)[i].var == var) return &((*cond)[i]);
-		return nullptr;
+		bool start = (p & 1) == 0;
+		int i = findFact(a, start ? SASActionTable::START_COND : SASActionTable::END_COND, var);
+		if (i >= 0) return start ? &(a->startCond[i]) : &(a->endCond[i]);
+		i = findFact(a, SASActionTable::OVER_COND, var);	// Check over-all conditions then
+		return i >= 0 ? &(a->overCond[i]) : nullptr;
 	}
 	inline SASCondition* getEffectValue(TTimePoint p, SASAction* a, TVariable var) {
-		std::vector<SASCondition>* eff = (p & 1) == 0 ? &(a->startEff) : &(a->endEff);
-		for (unsigned int i = 0; i < eff->size(); i++)
-			if ((*eff)[i].var == var) return &((*eff)[i]);
-		return nullptr;
+		bool start = (p & 1) == 0;
+		int i = findFact(a, start ? SASActionTable::START_EFF : SASActionTable::END_EFF, var);
+		if (i < 0) return nullptr;
+		return start ? &(a->startEff[i]) : &(a->endEff[i]);
 	}
 	bool goalsSupported(TState* s);
 	bool actionSupported(SASAction* a, TState* s);
@@ -12,6 +12,20 @@
 #include <iostream>
 using namespace std;
 
+// Returns the first term of a quantifier, which is replaced by its instances, and removes all the terms
+template<typename T> static T extractFirstTerm(std::vector<T> &terms) {
+    T first = std::move(terms[0]);
+    terms.clear();
+    return first;
+}
+
+// Replaces a node of a tree by one of its descendants. The descendant is moved out first, as it is destroyed
+// when the node is overwritten
+template<typename T> static void replaceByDescendant(T &node, T &descendant) {
+    T aux = std::move(descendant);
+    node = std::move(aux);
+}
+
 // Creates a new preprocessor
 Preprocess::Preprocess() {
 }
@@ -35,13 +49,15 @@ void Preprocess::preprocessOperators() {
         FeatureList features = { }; // Initialize to zero
         checkPreconditionFeatures(task->actions[i].precondition, &features);
         checkEffectFeatures(task->actions[i].effect, &features);
-        preprocessAction(task->actions[i], &features, false);
+        Action a = task->actions[i];
+        preprocessAction(a, &features, false);
     }
     for (unsigned int i = 0; i < task->durativeActions.size(); i++) {
         FeatureList features = { }; // Initialize to zero
         checkPreconditionFeatures(task->durativeActions[i].condition, &features);
         checkEffectFeatures(task->durativeActions[i].effect, &features);
-        preprocessAction(task->durativeActions[i], &features, false);
+        DurativeAction a = task->durativeActions[i];
+        preprocessAction(a, &features, false);
     }
     Action goalAction;
     goalAction.index = -1;
@@ -197,7 +213,7 @@ void Preprocess::checkGoalFeatures(DurativeCondition &goal, FeatureList* feature
 }
     
 // Processes an action and stores the result in a vector of simplified operators
-void Preprocess::preprocessAction(Action a, FeatureList* features, bool isGoal) {
+void Preprocess::preprocessAction(Action &a, FeatureList* features, bool isGoal) {
     if (features->universalQuantifierPrec > 0 || features->existentialQuantifierPrec > 0)
         removeQuantifiers(a.precondition, a.parameters.size());
     if (features->universalQuantifierEff > 0 || features->existentialQuantifierEff > 0)
@@ -212,14 +228,14 @@ void Preprocess::preprocessAction(Action a, FeatureList* features, bool isGoal)
     if (features->conditionalEff > 0) {
         removeConditionalEffects(a, aList);
     } else {
-        aList.push_back(a);
+        aList.push_back(std::move(a));
     }
     for (unsigned int i = 0; i < aList.size(); i++)
         buildOperators(aList[i], isGoal);
 }
 
 // Processes a durative action and stores the result in a vector of simplified operators
-void Preprocess::preprocessAction(DurativeAction a, FeatureList* features, bool isGoal) {
+void Preprocess::preprocessAction(DurativeAction &a, FeatureList* features, bool isGoal) {
     if (features->universalQuantifierPrec > 0 || features->existentialQuantifierPrec > 0)
         removeQuantifiers(a.condition, a.parameters.size());
     if (features->universalQuantifierEff > 0 || features->existentialQuantifierEff > 0)
@@ -234,7 +250,7 @@ void Preprocess::preprocessAction(DurativeAction a, FeatureList* features, bool
     if (features->conditionalEff > 0) {
         removeConditionalEffects(a, aList);
     } else {
-        aList.push_back(a);
+        aList.push_back(std::move(a));
     }
     for (unsigned int i = 0; i < aList.size(); i++)
         buildOperators(aList[i], isGoal);
@@ -256,15 +272,13 @@ void Preprocess::removeQuantifiers(Precondition &prec, unsigned int numParameter
         break;
     case PT_EXISTS:
         prec.type = PT_OR;
-        replaceQuantifierParameter(prec, prec.terms[0], 0, numParameters);
-        prec.terms.erase(prec.terms.begin());
+        replaceQuantifierParameter(prec, extractFirstTerm(prec.terms), 0, numParameters);
         for (unsigned int i = 0; i < prec.terms.size(); i++)
             removeQuantifiers(prec.terms[i], numParameters + prec.parameters.size());
         break;
     case PT_FORALL:
         prec.type = PT_AND;
-        replaceQuantifierParameter(prec, prec.terms[0], 0, numParameters);
-        prec.terms.erase(prec.terms.begin());
+        replaceQuantifierParameter(prec, extractFirstTerm(prec.terms), 0, numParameters);
         for (unsigned int i = 0; i < prec.terms.size(); i++)
             removeQuantifiers(prec.terms[i], numParameters + prec.parameters.size());
         break;
@@ -284,8 +298,7 @@ void Preprocess::removeQuantifiers(DurativeCondition &prec, unsigned int numPara
         break;
     case CT_FORALL:
         prec.type = CT_AND;
-        replaceQuantifierParameter(prec, prec.conditions[0], 0, numParameters);
-        prec.conditions.erase(prec.conditions.begin());
+        replaceQuantifierParameter(prec, extractFirstTerm(prec.conditions), 0, numParameters);
         for (unsigned int i = 0; i < prec.conditions.size(); i++)
             removeQuantifiers(prec.conditions[i], numParameters + prec.parameters.size());
         break;
@@ -309,8 +322,7 @@ void Preprocess::removeQuantifiers(Effect &eff, unsigned int numParameters) {
         break;
     case ET_FORALL:
         eff.type = ET_AND;
-        replaceQuantifierParameter(eff, eff.terms[0], 0, numParameters);
-        eff.terms.erase(eff.terms.begin());
+        replaceQuantifierParameter(eff, extractFirstTerm(eff.terms), 0, numParameters);
         for (unsigned int i = 0; i < eff.terms.size(); i++)
             removeQuantifiers(eff.terms[i], numParameters + eff.parameters.size());
         break;
@@ -327,8 +339,7 @@ void Preprocess::removeQuantifiers(DurativeEffect &eff, unsigned int numParamete
         break;
     case DET_FORALL:
         eff.type = DET_AND;
-        replaceQuantifierParameter(eff, eff.terms[0], 0, numParameters);
-        eff.terms.erase(eff.terms.begin());
+        replaceQuantifierParameter(eff, extractFirstTerm(eff.terms), 0, numParameters);
         for (unsigned int i = 0; i < eff.terms.size(); i++)
             removeQuantifiers(eff.terms[i], numParameters + eff.parameters.size());
         break;
@@ -357,15 +368,13 @@ void Preprocess::removeQuantifiers(GoalDescription &goal, unsigned int numParame
         break;
     case GD_EXISTS:
         goal.type = GD_OR;
-        replaceQuantifierParameter(goal, goal.terms[0], 0, numParameters);
-        goal.terms.erase(goal.terms.begin());
+        replaceQuantifierParameter(goal, extractFirstTerm(goal.terms), 0, numParameters);
         for (unsigned int i = 0; i < goal.terms.size(); i++)
             removeQuantifiers(goal.terms[i], numParameters + goal.parameters.size());
         break;
     case GD_FORALL:
         goal.type = GD_AND;
-        replaceQuantifierParameter(goal, goal.terms[0], 0, numParameters);
-        goal.terms.erase(goal.terms.begin());
+        replaceQuantifierParameter(goal, extractFirstTerm(goal.terms), 0, numParameters);
         for (unsigned int i = 0; i < goal.terms.size(); i++)
             removeQuantifiers(goal.terms[i], numParameters + goal.parameters.size());
         break;
@@ -374,81 +383,96 @@ void Preprocess::removeQuantifiers(GoalDescription &goal, unsigned int numParame
 }
 
 // Replaces the parameters of a quantifier by the task object that matches
-void Preprocess::replaceQuantifierParameter(Precondition &prec, Precondition term, 
+void Preprocess::replaceQuantifierParameter(Precondition &prec, const Precondition &term, 
         unsigned int paramNumber, unsigned int numParameters) {
     Variable &param = prec.parameters[paramNumber];
+    bool lastParameter = paramNumber + 1 == prec.parameters.size();
     for (unsigned int i = 0; i < task->objects.size(); i++) {
         if (task->compatibleTypes(task->objects[i].types, param.types)) {
-            Precondition updatedTerm = term;
-            replaceParameter(updatedTerm, paramNumber + numParameters, i);
-            if (paramNumber + 1 < prec.parameters.size())
+            if (lastParameter) {     // The instance is built in its final place
+                prec.terms.push_back(term);
+                replaceParameter(prec.terms.back(), paramNumber + numParameters, i);
+            } else {
+                Precondition updatedTerm = term;
+                replaceParameter(updatedTerm, paramNumber + numParameters, i);
                 replaceQuantifierParameter(prec, updatedTerm, paramNumber + 1, numParameters);
-            else
-                prec.terms.push_back(updatedTerm);
+            }
         }
     }
 }
 
 // Replaces the parameters of a quantifier by the task object that matches
-void Preprocess::replaceQuantifierParameter(DurativeCondition &prec, DurativeCondition term, 
+void Preprocess::replaceQuantifierParameter(DurativeCondition &prec, const DurativeCondition &term, 
         unsigned int paramNumber, unsigned int numParameters) {
     Variable &param = prec.parameters[paramNumber];
+    bool lastParameter = paramNumber + 1 == prec.parameters.size();
     for (unsigned int i = 0; i < task->objects.size(); i++) {
         if (task->compatibleTypes(task->objects[i].types, param.types)) {
-            DurativeCondition updatedTerm = term;
-            replaceParameter(updatedTerm, paramNumber + numParameters, i);
-            if (paramNumber + 1 < prec.parameters.size())
+            if (lastParameter) {     // The instance is built in its final place
+                prec.conditions.push_back(term);
+                replaceParameter(prec.conditions.back(), paramNumber + numParameters, i);
+            } else {
+                DurativeCondition updatedTerm = term;
+                replaceParameter(updatedTerm, paramNumber + numParameters, i);
                 replaceQuantifierParameter(prec, updatedTerm, paramNumber + 1, numParameters);
-            else
-                prec.conditions.push_back(updatedTerm);
+            }
         }
     }
 }
         
 // Replaces the parameters of a quantifier by the task object that matches
-void Preprocess::replaceQuantifierParameter(Effect &eff, Effect term, 
+void Preprocess::replaceQuantifierParameter(Effect &eff, const Effect &term, 
         unsigned int paramNumber, unsigned int numParameters) {
     Variable &param = eff.parameters[paramNumber];
+    bool lastParameter = paramNumber + 1 == eff.parameters.size();
     for (unsigned int i = 0; i < task->objects.size(); i++) {
         if (task->compatibleTypes(task->objects[i].types, param.types)) {
-            Effect updatedTerm = term;
-            replaceParameter(updatedTerm, paramNumber + numParameters, i);
-            if (paramNumber + 1 < eff.parameters.size())
+            if (lastParameter) {     // The instance is built in its final place
+                eff.terms.push_back(term);
+                replaceParameter(eff.terms.back(), paramNumber + numParameters, i);
+            } else {
+                Effect updatedTerm = term;
+                replaceParameter(updatedTerm, paramNumber + numParameters, i);
                 replaceQuantifierParameter(eff, updatedTerm, paramNumber + 1, numParameters);
-            else
-                eff.terms.push_back(updatedTerm);
+            }
         }
     }
 }
 
 // Replaces the parameters of a quantifier by the task object that matches
-void Preprocess::replaceQuantifierParameter(DurativeEffect &eff, DurativeEffect term, 
+void Preprocess::replaceQuantifierParameter(DurativeEffect &eff, const DurativeEffect &term, 
         unsigned int paramNumber, unsigned int numParameters) {
     Variable &param = eff.parameters[paramNumber];
+    bool lastParameter = paramNumber + 1 == eff.parameters.size();
     for (unsigned int i = 0; i < task->objects.size(); i++) {
         if (task->compatibleTypes(task->objects[i].types, param.types)) {
-            DurativeEffect updatedTerm = term;
-            replaceParameter(updatedTerm, paramNumber + numParameters, i);
-            if (paramNumber + 1 < eff.parameters.size())
+            if (lastParameter) {     // The instance is built in its final place
+                eff.terms.push_back(term);
+                replaceParameter(eff.terms.back(), paramNumber + numParameters, i);
+            } else {
+                DurativeEffect updatedTerm = term;
+                replaceParameter(updatedTerm, paramNumber + numParameters, i);
                 replaceQuantifierParameter(eff, updatedTerm, paramNumber + 1, numParameters);
-            else
-                eff.terms.push_back(updatedTerm);
+            }
         }
     }
 }
     
 // Replaces the parameters of a quantifier by the task object that matches
-void Preprocess::replaceQuantifierParameter(GoalDescription &goal, GoalDescription term, 
+void Preprocess::replaceQuantifierParameter(GoalDescription &goal, const GoalDescription &term, 
         unsigned int paramNumber, unsigned int numParameters) {
     Variable &param = goal.parameters[paramNumber];
+    bool lastParameter = paramNumber + 1 == goal.parameters.size();
     for (unsigned int i = 0; i < task->objects.size(); i++) {
         if (task->compatibleTypes(task->objects[i].types, param.types)) {
-            GoalDescription updatedTerm = term;
-            replaceParameter(updatedTerm, paramNumber + numParameters, i);
-            if (paramNumber + 1 < goal.parameters.size())
+            if (lastParameter) {     // The instance is built in its final place
+                goal.terms.push_back(term);
+                replaceParameter(goal.terms.back(), paramNumber + numParameters, i);
+            } else {
+                GoalDescription updatedTerm = term;
+                replaceParameter(updatedTerm, paramNumber + numParameters, i);
                 replaceQuantifierParameter(goal, updatedTerm, paramNumber + 1, numParameters);
-            else
-                goal.terms.push_back(updatedTerm);
+            }
         }
     }       
 }
@@ -670,8 +694,8 @@ void Preprocess::removeImplications(Precondition &prec) {
             Precondition &p = prec.terms[0];
             Precondition notP;
             notP.type = PT_NOT;
-            notP.terms.push_back(p);
-            prec.terms[0] = notP;
+            notP.terms.push_back(std::move(p));
+            prec.terms[0] = std::move(notP);
             removeImplications(prec.terms[0]);
             removeImplications(prec.terms[1]);
         }
@@ -746,8 +770,8 @@ void Preprocess::removeImplications(GoalDescription &goal) {
             GoalDescription &p = goal.terms[0];
             GoalDescription notP;
             notP.type = GD_NOT;
-            notP.terms.push_back(p);
-            goal.terms[0] = notP;
+            notP.terms.push_back(std::move(p));
+            goal.terms[0] = std::move(notP);
             removeImplications(goal.terms[0]);
             removeImplications(goal.terms[1]);
         }
@@ -765,12 +789,12 @@ void Preprocess::preconditionOptimization(Precondition *prec, Precondition *pare
         case PT_OR:
             if (n == 0) prec->type = PT_AND;    // Empty conjuntion/disjunction
             else if (n == 1) {                  // Unary conjuntion/disjunction
-                Precondition child = prec->terms[0];
+                Precondition child = std::move(prec->terms[0]);
                 if (parent == nullptr) {
-                    a.precondition = child;
+                    a.precondition = std::move(child);
                     preconditionOptimization(&a.precondition, nullptr, 0, a);
                 } else {
-                    parent->terms[termNumber] = child;
+                    parent->terms[termNumber] = std::move(child);
                     preconditionOptimization(&(parent->terms[termNumber]), parent, termNumber, a);
                 }
             } else {                            // Multiple conjuntion/disjunction
@@ -791,12 +815,12 @@ void Preprocess::preconditionOptimization(DurativeCondition *prec, DurativeCondi
     switch (prec->type) {
     case CT_AND:
         if (n == 1) {                       // Unary conjuntion/disjunction
-            DurativeCondition child = prec->conditions[0];
+            DurativeCondition child = std::move(prec->conditions[0]);
             if (parent == nullptr) {
-                a.condition = child;
+                a.condition = std::move(child);
                 preconditionOptimization(&a.condition, nullptr, 0, a);
             } else {
-                parent->conditions[termNumber] = child;
+                parent->conditions[termNumber] = std::move(child);
                 preconditionOptimization(&(parent->conditions[termNumber]), parent, termNumber, a);
             }
         } else {                            // Multiple conjuntion/disjunction
@@ -819,40 +843,43 @@ void Preprocess::negationOptimization(Precondition *prec, Precondition *parent,
     switch (child.type) {
     case PT_LITERAL:
         prec->type = PT_NEG_LITERAL;
-        prec->literal = child.literal;
+        prec->literal = std::move(child.literal);
         prec->terms.clear();
         break;
     case PT_AND:    // ~(A ^ B) = ~A v ~B
     case PT_OR:     // ~(A v B) = ~A ^ ~B
         prec->type = child.type == PT_AND ? PT_OR : PT_AND;
-        for (unsigned int i = 0; i < child.terms.size(); i++) {
-            Precondition notP;
-            notP.type = PT_NOT;
-            notP.terms.push_back(child.terms[i]);
-            prec->terms.push_back(notP);
+        {
+            vector<Precondition> terms = std::move(child.terms);    // child is destroyed when the terms are replaced
+            prec->terms.clear();
+            for (unsigned int i = 0; i < terms.size(); i++) {
+                Precondition notP;
+                notP.type = PT_NOT;
+                notP.terms.push_back(std::move(terms[i]));
+                prec->terms.push_back(std::move(notP));
+            }
         }
-        prec->terms.erase(prec->terms.begin());
         for (unsigned int i = 0; i < prec->terms.size(); i++)
             negationOptimization(&(prec->terms[i]), prec, i, a);
         break;
     case PT_NOT:    // Double negation: ~~A = A
         if (parent == nullptr) {
-            a.precondition = child.terms[0];
+            replaceByDescendant(a.precondition, child.terms[0]);
             preconditionOptimization(&a.precondition, nullptr, 0, a);
         } else {
-            parent->terms[termNumber] = child.terms[0];
+            replaceByDescendant(parent->terms[termNumber], child.terms[0]);
             preconditionOptimization(&(parent->terms[termNumber]), parent, termNumber, a); 
         }
         break;
     case PT_F_CMP:
         prec->type = PT_F_CMP;
-        prec->goal = prec->terms[0].goal;
+        prec->goal = std::move(prec->terms[0].goal);
         prec->goal.comparator = negateComparator(prec->goal.comparator);
         prec->terms.clear();
         break;
     case PT_EQUALITY:
         prec->type = PT_EQUALITY;
-        prec->goal = prec->terms[0].goal;
+        prec->goal = std::move(prec->terms[0].goal);
         prec->goal.type = prec->goal.type == GD_EQUALITY ? GD_INEQUALITY : GD_EQUALITY;
         prec->terms.clear();
         break;
@@ -878,12 +905,12 @@ void Preprocess::effectOptimization(Effect *eff, Effect *parent, unsigned int te
     switch (eff->type) {
         case ET_AND:
             if (n == 1) {                // Unary conjuntion
-                Effect child = eff->terms[0];
+                Effect child = std::move(eff->terms[0]);
                 if (parent == nullptr) {
-                    a.effect = child;
+                    a.effect = std::move(child);
                     effectOptimization(&a.effect, nullptr, 0, a);
                 } else {
-                    parent->terms[termNumber] = child;
+                    parent->terms[termNumber] = std::move(child);
                     effectOptimization(&(parent->terms[termNumber]), parent, termNumber, a);
                 }
             } else {                            // Multiple conjuntion/disjunction
@@ -908,12 +935,12 @@ void Preprocess::effectOptimization(DurativeEffect *eff, DurativeEffect *parent,
     switch (eff->type) {
         case DET_AND:
             if (n == 1) {                // Unary conjuntion
-                DurativeEffect child = eff->terms[0];
+                DurativeEffect child = std::move(eff->terms[0]);
                 if (parent == nullptr) {
-                    a.effect = child;
+                    a.effect = std::move(child);
                     effectOptimization(&a.effect, nullptr, 0, a);
                 } else {
-                    parent->terms[termNumber] = child;
+                    parent->terms[termNumber] = std::move(child);
                     effectOptimization(&(parent->terms[termNumber]), parent, termNumber, a);
                 }
             } else {                            // Multiple conjuntion/disjunction
@@ -940,12 +967,12 @@ void Preprocess::effectOptimization(TimedEffect* eff, TimedEffect* parent, unsig
         case TE_AND:
         case TE_OR:
             if (n == 1) {                // Unary conjuntion
-                TimedEffect child = eff->terms[0];
+                TimedEffect child = std::move(eff->terms[0]);
                 if (parent == nullptr) {
-                    parentEff->timedEffect = child;
+                    parentEff->timedEffect = std::move(child);
                     effectOptimization(&(parentEff->timedEffect), nullptr, 0, parentEff);
                 } else {
-                    parent->terms[termNumber] = child;
+                    parent->terms[termNumber] = std::move(child);
                     effectOptimization(&(parent->terms[termNumber]), parent, termNumber, nullptr);
                 }
             } else {                            // Multiple conjuntion/disjunction
@@ -968,12 +995,12 @@ void Preprocess::preconditionOptimization(DurativeCondition *prec, DurativeCondi
     switch (prec->type) {
     case CT_AND:
         if (n == 1) {                       // Unary conjuntion/disjunction
-            DurativeCondition child = prec->conditions[0];
+            DurativeCondition child = std::move(prec->conditions[0]);
             if (parent == nullptr) {
-                parentEff->condition = child;
+                parentEff->condition = std::move(child);
                 preconditionOptimization(&(parentEff->condition), nullptr, 0, parentEff);
             } else {
-                parent->conditions[termNumber] = child;
+                parent->conditions[termNumber] = std::move(child);
                 preconditionOptimization(&(parent->conditions[termNumber]), parent, termNumber, parentEff);
             }
         } else {                            // Multiple conjuntion/disjunction
@@ -996,28 +1023,31 @@ void Preprocess::negationOptimization(TimedEffect* eff, TimedEffect* parent, uns
         case TE_AND:    // ~(A ^ B) = ~A v ~B
         case TE_OR:     // ~(A v B) = ~A ^ ~B
             eff->type = child.type == TE_AND ? TE_OR : TE_AND;
-            for (unsigned int i = 0; i < child.terms.size(); i++) {
-                TimedEffect notP;
-                notP.type = TE_NOT;
-                notP.terms.push_back(child.terms[i]);
-                eff->terms.push_back(notP);
+            {
+                vector<TimedEffect> terms = std::move(child.terms);    // child is destroyed when the terms are replaced
+                eff->terms.clear();
+                for (unsigned int i = 0; i < terms.size(); i++) {
+                    TimedEffect notP;
+                    notP.type = TE_NOT;
+                    notP.terms.push_back(std::move(terms[i]));
+                    eff->terms.push_back(std::move(notP));
+                }
             }
-            eff->terms.erase(eff->terms.begin());
             for (unsigned int i = 0; i < eff->terms.size(); i++)
                 negationOptimization(&(eff->terms[i]), eff, i, parentEff);
             break;
         case TE_NOT:    // Double negation: ~~A = A
             if (parent != nullptr) {
-                parent->terms[termNumber] = child.terms[0];
+                replaceByDescendant(parent->terms[termNumber], child.terms[0]);
                 effectOptimization(&(parent->terms[termNumber]), parent, termNumber, parentEff);
             } else {
-                parentEff->timedEffect = child.terms[0];
+                replaceByDescendant(parentEff->timedEffect, child.terms[0]);
                 effectOptimization(&(parentEff->timedEffect), nullptr, 0, parentEff);
             }
             break;
         case TE_LITERAL:
             eff->type = TE_NEG_LITERAL;
-            eff->literal = child.literal;
+            eff->literal = std::move(child.literal);
             eff->terms.clear();
             break;
         case TE_ASSIGNMENT:;
@@ -1032,15 +1062,15 @@ void Preprocess::negationOptimization(Effect *eff, Effect *parent, unsigned int
     switch (child.type) {
     case ET_LITERAL:
         eff->type = ET_NEG_LITERAL;
-        eff->literal = child.literal;
+        eff->literal = std::move(child.literal);
         eff->terms.clear();
         break;
     case ET_NOT:    // Double negation: ~~A = A
         if (parent == nullptr) {
-            a.effect = child.terms[0];
+            replaceByDescendant(a.effect, child.terms[0]);
             effectOptimization(&a.effect, nullptr, 0, a);
         } else {
-            parent->terms[termNumber] = child.terms[0];
+            replaceByDescendant(parent->terms[termNumber], child.terms[0]);
             effectOptimization(&(parent->terms[termNumber]), parent, termNumber, a); 
         }
         break;
@@ -1060,15 +1090,15 @@ void Preprocess::goalOptimization(GoalDescription *goal, Precondition *parentPre
         case GD_OR:
             if (n == 0) goal->type = GD_AND;    // Empty conjuntion/disjunction
             else if (n == 1) {                  // Unary conjuntion/disjunction
-                GoalDescription child = goal->terms[0];
+                GoalDescription child = std::move(goal->terms[0]);
                 if (parent != nullptr) {
-                    parent->terms[termNumber] = child;
+                    parent->terms[termNumber] = std::move(child);
                     goalOptimization(&(parent->terms[termNumber]), nullptr, nullptr, parent, termNumber);
                 } else if (parentPrec != nullptr) {
-                    parentPrec->goal = child;
+                    parentPrec->goal = std::move(child);
                     goalOptimization(&(parentPrec->goal), parentPrec, nullptr, nullptr, 0);
                 } else {
-                    parentEff->goal = child;
+                    parentEff->goal = std::move(child);
                     goalOptimization(&(parentEff->goal), nullptr, parentEff, nullptr, 0);
                 }
             } else {                            // Multiple conjuntion/disjunction
@@ -1092,12 +1122,12 @@ void Preprocess::goalOptimization(GoalDescription *goal, DurativeCondition *pare
         case GD_OR:
             if (n == 0) goal->type = GD_AND;    // Empty conjuntion/disjunction
             else if (n == 1) {                  // Unary conjuntion/disjunction
-                GoalDescription child = goal->terms[0];
+                GoalDescription child = std::move(goal->terms[0]);
                 if (parent != nullptr) {
-                    parent->terms[termNumber] = child;
+                    parent->terms[termNumber] = std::move(child);
                     goalOptimization(&(parent->terms[termNumber]), nullptr, parent, termNumber);
                 } else {
-                    parentPrec->goal = child;
+                    parentPrec->goal = std::move(child);
                     goalOptimization(&(parentPrec->goal), parentPrec, nullptr, 0);
                 }
             } else {                            // Multiple conjuntion/disjunction
@@ -1120,7 +1150,7 @@ void Preprocess::negationOptimization(GoalDescription *goal, DurativeCondition *
     case GD_LITERAL:
          //cout << "Child literal" << endl;
         goal->type = GD_NEG_LITERAL;
-        goal->literal = child.literal;
+        goal->literal = std::move(child.literal);
         goal->time = child.time;
         goal->terms.clear();
         break;
@@ -1128,23 +1158,26 @@ void Preprocess::negationOptimization(GoalDescription *goal, DurativeCondition *
     case GD_OR:     // ~(A v B) = ~A ^ ~B
         //cout << "Child and/or" << endl;
         goal->type = child.type == GD_AND ? GD_OR : GD_AND;
-        for (unsigned int i = 0; i < child.terms.size(); i++) {
-            GoalDescription notP;
-            notP.type = GD_NOT;
-            notP.terms.push_back(child.terms[i]);
-            goal->terms.push_back(notP);
+        {
+            vector<GoalDescription> terms = std::move(child.terms);    // child is destroyed when the terms are replaced
+            goal->terms.clear();
+            for (unsigned int i = 0; i < terms.size(); i++) {
+                GoalDescription notP;
+                notP.type = GD_NOT;
+                notP.terms.push_back(std::move(terms[i]));
+                goal->terms.push_back(std::move(notP));
+            }
         }
-        goal->terms.erase(goal->terms.begin());
         for (unsigned int i = 0; i < goal->terms.size(); i++)
             negationOptimization(&(goal->terms[i]), nullptr, nullptr, goal, i);
         break;
     case GD_NOT:    // Double negation: ~~A = A
         //cout << "Child not" << endl;
         if (parent != nullptr) {
-            parent->terms[termNumber] = child.terms[0];
+            replaceByDescendant(parent->terms[termNumber], child.terms[0]);
             goalOptimization(&(parent->terms[termNumber]), nullptr, nullptr, parent, termNumber);
         } else {
-            parentPrec->goal = child.terms[0];
+            replaceByDescendant(parentPrec->goal, child.terms[0]);
             goalOptimization(&(parentPrec->goal), parentPrec, nullptr, 0);
         }
         break;
@@ -1152,7 +1185,7 @@ void Preprocess::negationOptimization(GoalDescription *goal, DurativeCondition *
          //cout << "Child cmp" << endl;
         goal->type = GD_F_CMP;
         goal->time = child.time;
-        goal->exp = goal->terms[0].exp;
+        goal->exp = std::move(goal->terms[0].exp);
         goal->comparator = negateComparator(child.comparator);
         goal->terms.clear();
         break;
@@ -1160,7 +1193,7 @@ void Preprocess::negationOptimization(GoalDescription *goal, DurativeCondition *
          //cout << "Child equality" << endl;
         goal->type = GD_INEQUALITY;
         goal->time = child.time;
-        goal->eqTerms = goal->terms[0].eqTerms;
+        goal->eqTerms = std::move(goal->terms[0].eqTerms);
         goal->terms.clear();
         break;
     default:;
@@ -1174,46 +1207,49 @@ void Preprocess::negationOptimization(GoalDescription *goal, Precondition *paren
     switch (child.type) {
     case GD_LITERAL:
         goal->type = GD_NEG_LITERAL;
-        goal->literal = child.literal;
+        goal->literal = std::move(child.literal);
         goal->time = child.time;
         goal->terms.clear();
         break;
     case GD_AND:    // ~(A ^ B) = ~A v ~B
     case GD_OR:     // ~(A v B) = ~A ^ ~B
         goal->type = child.type == GD_AND ? GD_OR : GD_AND;
-        for (unsigned int i = 0; i < child.terms.size(); i++) {
-            GoalDescription notP;
-            notP.type = GD_NOT;
-            notP.terms.push_back(child.terms[i]);
-            goal->terms.push_back(notP);
+        {
+            vector<GoalDescription> terms = std::move(child.terms);    // child is destroyed when the terms are replaced
+            goal->terms.clear();
+            for (unsigned int i = 0; i < terms.size(); i++) {
+                GoalDescription notP;
+                notP.type = GD_NOT;
+                notP.terms.push_back(std::move(terms[i]));
+                goal->terms.push_back(std::move(notP));
+            }
         }
-        goal->terms.erase(goal->terms.begin());
         for (unsigned int i = 0; i < goal->terms.size(); i++)
             negationOptimization(&(goal->terms[i]), nullptr, nullptr, goal, i);
         break;
     case GD_NOT:    // Double negation: ~~A = A
         if (parent != nullptr) {
-            parent->terms[termNumber] = child.terms[0];
+            replaceByDescendant(parent->terms[termNumber], child.terms[0]);
             goalOptimization(&(parent->terms[termNumber]), nullptr, nullptr, parent, termNumber);
         } else if (parentPrec != nullptr) {
-            parentPrec->goal = child.terms[0];
+            replaceByDescendant(parentPrec->goal, child.terms[0]);
             goalOptimization(&(parentPrec->goal), parentPrec, nullptr, nullptr, 0);
         } else {
-            parentEff->goal = child.terms[0];
+            replaceByDescendant(parentEff->goal, child.terms[0]);
             goalOptimization(&(parentEff->goal), nullptr, parentEff, nullptr, 0);
         }
         break;
     case GD_F_CMP:
         goal->type = GD_F_CMP;
         goal->time = child.time;
-        goal->exp = goal->terms[0].exp;
+        goal->exp = std::move(goal->terms[0].exp);
         goal->comparator = negateComparator(child.comparator);
         goal->terms.clear();
         break;
     case GD_EQUALITY:
         goal->type = GD_INEQUALITY;
         goal->time = child.time;
-        goal->eqTerms = goal->terms[0].eqTerms;
+        goal->eqTerms = std::move(goal->terms[0].eqTerms);
         goal->terms.clear();
         break;
     default:;
@@ -1221,7 +1257,7 @@ void Preprocess::negationOptimization(GoalDescription *goal, Precondition *paren
 }
 
 // Removes the conditional effects from the given action. Resulting actions are stored in aList
-void Preprocess::removeConditionalEffects(Action a, vector<Action> &aList) {
+void Preprocess::removeConditionalEffects(Action &a, vector<Action> &aList) {
     if (existingConditionalEffects(a.effect)) {
         ignoreConditionalEffect(a, aList);
         considerConditionalEffect(a, aList);
@@ -1229,7 +1265,7 @@ void Preprocess::removeConditionalEffects(Action a, vector<Action> &aList) {
 }
 
 // Removes the conditional effects from the given action. Resulting actions are stored in aList
-void Preprocess::removeConditionalEffects(DurativeAction a, std::vector<DurativeAction> &aList) {
+void Preprocess::removeConditionalEffects(DurativeAction &a, std::vector<DurativeAction> &aList) {
     if (existingConditionalEffects(a.effect)) {
         ignoreConditionalEffect(a, aList);
         considerConditionalEffect(a, aList);
@@ -1274,46 +1310,48 @@ bool Preprocess::existingConditionalEffects(DurativeEffect &eff) {
 }
     
 // Recursively removes the conditional effects from the action
-void Preprocess::ignoreConditionalEffect(Action a, std::vector<Action> &aList) {
-    removeConditionalEffect(&(a.effect), nullptr, 0, a);
-    if (existingConditionalEffects(a.effect)) {
-        ignoreConditionalEffect(a, aList);
-        considerConditionalEffect(a, aList);
+void Preprocess::ignoreConditionalEffect(Action &a, std::vector<Action> &aList) {
+    Action b = a;                         // The given action is not modified
+    removeConditionalEffect(&(b.effect), nullptr, 0, b);
+    if (existingConditionalEffects(b.effect)) {
+        ignoreConditionalEffect(b, aList);
+        considerConditionalEffect(b, aList);
     } else {
-        aList.push_back(a);
+        aList.push_back(std::move(b));
     }
 }
 
 // Recursively removes the conditional effects from the action
-void Preprocess::ignoreConditionalEffect(DurativeAction a, std::vector<DurativeAction> &aList) {
-    removeConditionalEffect(&(a.effect), nullptr, 0, a);
-    if (existingConditionalEffects(a.effect)) {
-        ignoreConditionalEffect(a, aList);
-        considerConditionalEffect(a, aList);
+void Preprocess::ignoreConditionalEffect(DurativeAction &a, std::vector<DurativeAction> &aList) {
+    DurativeAction b = a;                         // The given action is not modified
+    removeConditionalEffect(&(b.effect), nullptr, 0, b);
+    if (existingConditionalEffects(b.effect)) {
+        ignoreConditionalEffect(b, aList);
+        considerConditionalEffect(b, aList);
     } else {
-        aList.push_back(a);
+        aList.push_back(std::move(b));
     }
 }
     
 // Recursively removes the conditional effects from the action
-void Preprocess::considerConditionalEffect(Action a, std::vector<Action> &aList) {
+void Preprocess::considerConditionalEffect(Action &a, std::vector<Action> &aList) {
     manageConditionalEffect(&(a.effect), nullptr, 0, a);
     if (existingConditionalEffects(a.effect)) {
         ignoreConditionalEffect(a, aList);
         considerConditionalEffect(a, aList);
     } else {
-        aList.push_back(a);
+        aList.push_back(std::move(a));
     }
 }
 
 // Recursively removes the conditional effects from the action
-void Preprocess::considerConditionalEffect(DurativeAction a, std::vector<DurativeAction> &aList) {
+void Preprocess::considerConditionalEffect(DurativeAction &a, std::vector<DurativeAction> &aList) {
     manageConditionalEffect(&(a.effect), 0, a);
     if (existingConditionalEffects(a.effect)) {
         ignoreConditionalEffect(a, aList);
         considerConditionalEffect(a, aList);
     } else {
-        aList.push_back(a);
+        aList.push_back(std::move(a));
     }
 }
     
@@ -1390,19 +1428,18 @@ bool Preprocess::manageConditionalEffect(Effect *eff, Effect *parent, int numTer
     case ET_WHEN:
         {
             if (a.precondition.type != PT_AND) {
-                Precondition backup = a.precondition;
                 Precondition root;
                 root.type = PT_AND;
-                root.terms.push_back(backup);
-                a.precondition = root;
+                root.terms.push_back(std::move(a.precondition));
+                a.precondition = std::move(root);
             }
             Precondition newPrec;
             newPrec.type = PT_GOAL;
-            newPrec.goal = eff->goal;
-            a.precondition.terms.push_back(newPrec);
-            Effect q = eff->terms[0];
-            if (parent != nullptr) parent->terms[numTerm] = q;
-            else a.effect = q;
+            newPrec.goal = std::move(eff->goal);
+            a.precondition.terms.push_back(std::move(newPrec));
+            Effect q = std::move(eff->terms[0]);
+            if (parent != nullptr) parent->terms[numTerm] = std::move(q);
+            else a.effect = std::move(q);
             managed = true;
         }
         break;
@@ -1422,13 +1459,12 @@ bool Preprocess::manageConditionalEffect(DurativeEffect *eff, int numTerm, Durat
     case DET_WHEN:
         {
             if (a.condition.type != CT_AND) {
-                DurativeCondition backup = a.condition;
                 DurativeCondition root;
                 root.type = CT_AND;
-                root.conditions.push_back(backup);
-                a.condition = root;
+                root.conditions.push_back(std::move(a.condition));
+                a.condition = std::move(root);
             }
-            a.condition.conditions.push_back(eff->condition);
+            a.condition.conditions.push_back(std::move(eff->condition));
             eff->type = DET_TIMED_EFFECT;
             managed = true;
         }
@@ -1629,7 +1665,7 @@ vector<Operator> Preprocess::buildOperatorPreconditionAnd(Precondition &prec, Ac
     vector<Operator> result;
     for (unsigned int i = 0; i < opList.size(); i++) {
         vector<Operator> partial = buildOperatorPreconditionAnd(prec, a, &opList[i], numTerm);
-        result.insert(result.end(), partial.begin(), partial.end());
+        result.insert(result.end(), make_move_iterator(partial.begin()), make_move_iterator(partial.end()));
     }
     return result;
 }
@@ -1641,7 +1677,7 @@ vector<Operator> Preprocess::buildOperatorPreconditionAnd(DurativeCondition &pre
     vector<Operator> result;
     for (unsigned int i = 0; i < opList.size(); i++) {
         vector<Operator> partial = buildOperatorPreconditionAnd(prec, a, &opList[i], numTerm);
-        result.insert(result.end(), partial.begin(), partial.end());
+        result.insert(result.end(), make_move_iterator(partial.begin()), make_move_iterator(partial.end()));
     }
     return result;
 }
@@ -1653,7 +1689,7 @@ vector<Operator> Preprocess::buildOperatorPreconditionAnd(GoalDescription &goal,
     vector<Operator> result;
     for (unsigned int i = 0; i < opList.size(); i++) {
         vector<Operator> partial = buildOperatorPreconditionAnd(goal, a, &opList[i], numTerm);
-        result.insert(result.end(), partial.begin(), partial.end());
+        result.insert(result.end(), make_move_iterator(partial.begin()), make_move_iterator(partial.end()));
     }
     return result;
 }
@@ -1665,7 +1701,7 @@ vector<Operator> Preprocess::buildOperatorPreconditionAnd(GoalDescription &goal,
     vector<Operator> result;
     for (unsigned int i = 0; i < opList.size(); i++) {
         vector<Operator> partial = buildOperatorPreconditionAnd(goal, a, &opList[i], numTerm);
-        result.insert(result.end(), partial.begin(), partial.end());
+        result.insert(result.end(), make_move_iterator(partial.begin()), make_move_iterator(partial.end()));
     }
     return result;
 }
@@ -1771,7 +1807,7 @@ void Preprocess::terminateBuildingOperator(Operator &op, Action &a) {
     NumericExpression durExp(EPSILON);
     op.duration.emplace_back(Symbol::EQUAL, durExp);
     buildOperatorEffect(op, a.effect);
-    prepTask->operators.push_back(op);
+    prepTask->operators.push_back(std::move(op));
 }
 
 // Terminates to build de operator (only its preconditions are built)
@@ -1781,7 +1817,7 @@ void Preprocess::terminateBuildingOperator(Operator &op, DurativeAction &a) {
     op.parameters = a.parameters;
     op.duration = a.duration;
     buildOperatorEffect(op, a.effect);
-    prepTask->operators.push_back(op);
+    prepTask->operators.push_back(std::move(op));
 }
 
 // Adds action effects to the operators
@@ -27,22 +27,22 @@ private:
     void checkGoalFeatures(DurativeCondition &goal, FeatureList* features);
     void checkEffectFeatures(Effect &eff, FeatureList* features);
     void checkEffectFeatures(DurativeEffect &eff, FeatureList* features);
-    void preprocessAction(Action a, FeatureList* features, bool isGoal);
-    void preprocessAction(DurativeAction a, FeatureList* features, bool isGoal);
+    void preprocessAction(Action &a, FeatureList* features, bool isGoal);
+    void preprocessAction(DurativeAction &a, FeatureList* features, bool isGoal);
     void removeQuantifiers(Precondition &prec, unsigned int numParameters);
     void removeQuantifiers(DurativeCondition &prec, unsigned int numParameters);
     void removeQuantifiers(Effect &eff, unsigned int numParameters);
     void removeQuantifiers(DurativeEffect &eff, unsigned int numParameters);
     void removeQuantifiers(GoalDescription &goal, unsigned int numParameters);
-    void replaceQuantifierParameter(Precondition &prec, Precondition term, 
+    void replaceQuantifierParameter(Precondition &prec, const Precondition &term, 
         unsigned int paramNumber, unsigned int numParameters);
-    void replaceQuantifierParameter(DurativeCondition &prec, DurativeCondition term, 
+    void replaceQuantifierParameter(DurativeCondition &prec, const DurativeCondition &term, 
         unsigned int paramNumber, unsigned int numParameters);
-    void replaceQuantifierParameter(Effect &eff, Effect term, 
+    void replaceQuantifierParameter(Effect &eff, const Effect &term, 
         unsigned int paramNumber, unsigned int numParameters);
-    void replaceQuantifierParameter(DurativeEffect &eff, DurativeEffect term, 
+    void replaceQuantifierParameter(DurativeEffect &eff, const DurativeEffect &term, 
         unsigned int paramNumber, unsigned int numParameters);
-    void replaceQuantifierParameter(GoalDescription &goal, GoalDescription term, 
+    void replaceQuantifierParameter(GoalDescription &goal, const GoalDescription &term, 
         unsigned int paramNumber, unsigned int numParameters);
     void replaceParameter(Precondition &term, unsigned int paramToReplace, unsigned int objectIndex);   
     void replaceParameter(DurativeCondition &term, unsigned int paramToReplace, unsigned int objectIndex);   
@@ -78,12 +78,12 @@ private:
         GoalDescription *parent, unsigned int termNumber);
     void negationOptimization(GoalDescription *goal, DurativeCondition *parentPrec, 
         GoalDescription *parent, unsigned int termNumber);
-    void removeConditionalEffects(Action a, std::vector<Action> &aList);
-    void removeConditionalEffects(DurativeAction a, std::vector<DurativeAction> &aList);
-    void ignoreConditionalEffect(Action a, std::vector<Action> &aList);
-    void ignoreConditionalEffect(DurativeAction a, std::vector<DurativeAction> &aList);
-    void considerConditionalEffect(Action a, std::vector<Action> &aList);
-    void considerConditionalEffect(DurativeAction a, std::vector<DurativeAction> &aList);
+    void removeConditionalEffects(Action &a, std::vector<Action> &aList);
+    void removeConditionalEffects(DurativeAction &a, std::vector<DurativeAction> &aList);
+    void ignoreConditionalEffect(Action &a, std::vector<Action> &aList);
+    void ignoreConditionalEffect(DurativeAction &a, std::vector<DurativeAction> &aList);
+    void considerConditionalEffect(Action &a, std::vector<Action> &aList);
+    void considerConditionalEffect(DurativeAction &a, std::vector<DurativeAction> &aList);
     bool removeConditionalEffect(Effect *eff, Effect *parent, int numTerm, Action &a);
     bool removeConditionalEffect(DurativeEffect *eff, DurativeEffect *parent, int numTerm, DurativeAction &a);
     bool manageConditionalEffect(Effect *eff, Effect *parent, int numTerm, Action &a);
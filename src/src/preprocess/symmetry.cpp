@@ -0,0 +1,250 @@
+/********************************************************/
+/* Detection of symmetric objects in the parsed task.   */
+/* Two objects are symmetric if swapping them maps the  */
+/* initial state and the goals onto themselves. The     */
+/* relation is an equivalence, so the objects are       */
+/* grouped into orbits.                                 */
+/********************************************************/
+
+#include "symmetry.hpp"
+#include "../utils/utils.hpp"
+#include <map>
+#include <algorithm>
+#include <cstring>
+using namespace std;
+
+#define FACT_KIND		0		// Positions in the encoded facts
+#define FACT_FUNCTION	1
+#define FACT_OBJ_VALUE	2
+#define FACT_VALUE		3
+#define FACT_TIME		4
+#define FACT_PARAMS		5
+
+#define KIND_INIT		0
+#define KIND_GOAL		1
+#define KIND_NEG_GOAL	2
+
+/********************************************************/
+/* CLASS: SymmetryDetector                              */
+/********************************************************/
+
+// Computes the orbits of symmetric objects
+void SymmetryDetector::detectSymmetries(ParsedTask* task) {
+	this->task = task;
+	unsigned int numObjects = task->objects.size();
+	fixedObject.assign(numObjects, false);
+	for (unsigned int i = 0; i < numObjects; i++)
+		fixedObject[i] = task->objects[i].isConstant;
+	facts.clear();
+	factSet.clear();
+	factsOfObject.assign(numObjects, vector<unsigned int>());
+	for (unsigned int i = 0; i < task->init.size(); i++)
+		addFact(task->init[i]);
+	addGoal(task->goal);
+	for (unsigned int i = 0; i < task->constraints.size(); i++)
+		fixObjects(task->constraints[i]);
+	if (task->metricType != MT_NONE)
+		fixObjects(task->metric);
+	map< vector<unsigned int>, vector<unsigned int> > candidates;	// Objects with the same types and occurrences
+	for (unsigned int i = 0; i < numObjects; i++)
+		if (!fixedObject[i])
+			candidates[getSignature(i)].push_back(i);
+	orbits.clear();
+	orbitOfObject.assign(numObjects, MAX_UNSIGNED_INT);
+	for (map< vector<unsigned int>, vector<unsigned int> >::iterator it = candidates.begin(); it != candidates.end(); ++it) {
+		vector<unsigned int> &objs = it->second;
+		if (objs.size() < 2) continue;
+		vector< vector<unsigned int> > groups;
+		for (unsigned int i = 0; i < objs.size(); i++) {
+			unsigned int j = 0;
+			while (j < groups.size() && !areSymmetric(groups[j][0], objs[i])) j++;
+			if (j == groups.size()) groups.emplace_back();
+			groups[j].push_back(objs[i]);
+		}
+		for (unsigned int j = 0; j < groups.size(); j++) {
+			if (groups[j].size() < 2) continue;
+			for (unsigned int k = 0; k < groups[j].size(); k++)
+				orbitOfObject[groups[j][k]] = orbits.size();
+			orbits.push_back(groups[j]);
+		}
+	}
+	facts.clear();
+	factSet.clear();
+	factsOfObject.clear();
+}
+
+// Returns the number of objects that have some symmetric object
+unsigned int SymmetryDetector::getNumSymmetricObjects() {
+	unsigned int n = 0;
+	for (unsigned int i = 0; i < orbits.size(); i++)
+		n += orbits[i].size();
+	return n;
+}
+
+// Adds an initial-state fact
+void SymmetryDetector::addFact(Fact &f) {
+	vector<unsigned int> fact(FACT_PARAMS + f.parameters.size());
+	fact[FACT_KIND] = KIND_INIT;
+	fact[FACT_FUNCTION] = f.function;
+	fact[FACT_OBJ_VALUE] = f.valueIsNumeric ? 0 : 1;
+	if (f.valueIsNumeric) memcpy(&fact[FACT_VALUE], &f.numericValue, sizeof(float));
+	else fact[FACT_VALUE] = f.value;
+	memcpy(&fact[FACT_TIME], &f.time, sizeof(float));
+	for (unsigned int i = 0; i < f.parameters.size(); i++)
+		fact[FACT_PARAMS + i] = f.parameters[i];
+	addFact(fact);
+}
+
+// Adds a literal of the goal conjunction
+void SymmetryDetector::addGoalLiteral(Literal &l, bool negated) {
+	vector<unsigned int> fact(FACT_PARAMS + l.params.size(), 0);
+	fact[FACT_KIND] = negated ? KIND_NEG_GOAL : KIND_GOAL;
+	fact[FACT_FUNCTION] = l.fncIndex;
+	for (unsigned int i = 0; i < l.params.size(); i++) {
+		if (l.params[i].isVariable) {		// Not a ground literal
+			fixObjects(l);
+			return;
+		}
+		fact[FACT_PARAMS + i] = l.params[i].index;
+	}
+	addFact(fact);
+}
+
+// Stores an encoded fact and the objects that appear in it
+void SymmetryDetector::addFact(vector<unsigned int> &fact) {
+	if (!factSet.insert(fact).second) return;		// Repeated fact
+	unsigned int index = facts.size();
+	for (unsigned int i = FACT_VALUE; i < fact.size(); i++)
+		if (isObjectPosition(fact, i)) {
+			vector<unsigned int> &v = factsOfObject[fact[i]];
+			if (v.empty() || v.back() != index) v.push_back(index);
+		}
+	facts.push_back(fact);
+}
+
+// Checks if a position of an encoded fact holds an object
+bool SymmetryDetector::isObjectPosition(vector<unsigned int> &fact, unsigned int pos) {
+	if (pos >= FACT_PARAMS) return true;
+	return pos == FACT_VALUE && fact[FACT_KIND] == KIND_INIT && fact[FACT_OBJ_VALUE] == 1;
+}
+
+// Adds the goals. Only conjunctions of literals are encoded, the objects in other goals are fixed
+void SymmetryDetector::addGoal(Precondition &p) {
+	switch (p.type) {
+	case PT_LITERAL:		addGoalLiteral(p.literal, false);	break;
+	case PT_NEG_LITERAL:	addGoalLiteral(p.literal, true);	break;
+	case PT_AND:
+		for (unsigned int i = 0; i < p.terms.size(); i++)
+			addGoal(p.terms[i]);
+		break;
+	case PT_GOAL:			addGoal(p.goal);					break;
+	default:				fixObjects(p);
+	}
+}
+
+// Adds the goals. Only conjunctions of literals are encoded, the objects in other goals are fixed
+void SymmetryDetector::addGoal(GoalDescription &g) {
+	switch (g.type) {
+	case GD_LITERAL:		addGoalLiteral(g.literal, false);	break;
+	case GD_NEG_LITERAL:	addGoalLiteral(g.literal, true);	break;
+	case GD_AND:
+		for (unsigned int i = 0; i < g.terms.size(); i++)
+			addGoal(g.terms[i]);
+		break;
+	default:				fixObjects(g);
+	}
+}
+
+// Fixes the object in a term
+void SymmetryDetector::fixObjects(Term &t) {
+	if (!t.isVariable) fixedObject[t.index] = true;
+}
+
+// Fixes the objects in a literal
+void SymmetryDetector::fixObjects(Literal &l) {
+	for (unsigned int i = 0; i < l.params.size(); i++)
+		fixObjects(l.params[i]);
+}
+
+// Fixes the objects in a numeric expression
+void SymmetryDetector::fixObjects(NumericExpression &e) {
+	if (e.type == NET_FUNCTION) fixObjects(e.function);
+	else if (e.type == NET_TERM) fixObjects(e.term);
+	for (unsigned int i = 0; i < e.operands.size(); i++)
+		fixObjects(e.operands[i]);
+}
+
+// Fixes the objects in a goal description
+void SymmetryDetector::fixObjects(GoalDescription &g) {
+	fixObjects(g.literal);
+	for (unsigned int i = 0; i < g.terms.size(); i++)
+		fixObjects(g.terms[i]);
+	for (unsigned int i = 0; i < g.exp.size(); i++)
+		fixObjects(g.exp[i]);
+	for (unsigned int i = 0; i < g.eqTerms.size(); i++)
+		fixObjects(g.eqTerms[i]);
+}
+
+// Fixes the objects in a precondition
+void SymmetryDetector::fixObjects(Precondition &p) {
+	fixObjects(p.literal);
+	for (unsigned int i = 0; i < p.terms.size(); i++)
+		fixObjects(p.terms[i]);
+	fixObjects(p.goal);
+}
+
+// Fixes the objects in a constraint
+void SymmetryDetector::fixObjects(Constraint &c) {
+	for (unsigned int i = 0; i < c.terms.size(); i++)
+		fixObjects(c.terms[i]);
+	for (unsigned int i = 0; i < c.goal.size(); i++)
+		fixObjects(c.goal[i]);
+}
+
+// Fixes the objects in the metric
+void SymmetryDetector::fixObjects(Metric &m) {
+	for (unsigned int i = 0; i < m.parameters.size(); i++)
+		fixedObject[m.parameters[i]] = true;
+	for (unsigned int i = 0; i < m.terms.size(); i++)
+		fixObjects(m.terms[i]);
+}
+
+// Types and occurrences (kind of fact, function and position) of an object. Symmetric objects have the same signature
+vector<unsigned int> SymmetryDetector::getSignature(unsigned int o) {
+	vector<unsigned int> types = task->objects[o].types;
+	sort(types.begin(), types.end());
+	vector<uint64_t> occurrences;
+	vector<unsigned int> &objFacts = factsOfObject[o];
+	for (unsigned int i = 0; i < objFacts.size(); i++) {
+		vector<unsigned int> &fact = facts[objFacts[i]];
+		for (unsigned int j = FACT_VALUE; j < fact.size(); j++)
+			if (isObjectPosition(fact, j) && fact[j] == o)
+				occurrences.push_back(((uint64_t) fact[FACT_KIND] << 48) + ((uint64_t) fact[FACT_FUNCTION] << 16) + j);
+	}
+	sort(occurrences.begin(), occurrences.end());
+	vector<unsigned int> signature;
+	signature.push_back(types.size());
+	signature.insert(signature.end(), types.begin(), types.end());
+	for (unsigned int i = 0; i < occurrences.size(); i++) {
+		signature.push_back((unsigned int) (occurrences[i] >> 32));
+		signature.push_back((unsigned int) occurrences[i]);
+	}
+	return signature;
+}
+
+// Checks if swapping two objects maps every fact onto another fact. The facts without these objects do not change
+bool SymmetryDetector::areSymmetric(unsigned int o1, unsigned int o2) {
+	for (unsigned int k = 0; k < 2; k++) {
+		vector<unsigned int> &objFacts = factsOfObject[k == 0 ? o1 : o2];
+		for (unsigned int i = 0; i < objFacts.size(); i++) {
+			vector<unsigned int> image = facts[objFacts[i]];
+			for (unsigned int j = FACT_VALUE; j < image.size(); j++)
+				if (isObjectPosition(image, j)) {
+					if (image[j] == o1) image[j] = o2;
+					else if (image[j] == o2) image[j] = o1;
+				}
+			if (factSet.find(image) == factSet.end()) return false;
+		}
+	}
+	return true;
+}
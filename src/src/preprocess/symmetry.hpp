@@ -0,0 +1,47 @@
+#ifndef SYMMETRY_H
+#define SYMMETRY_H
+
+/********************************************************/
+/* Detection of symmetric objects in the parsed task:   */
+/* objects that can be swapped without changing the     */
+/* initial state and the goals, grouped into orbits.    */
+/********************************************************/
+
+#include <set>
+#include <vector>
+#include "../parser/parsedTask.hpp"
+
+class SymmetryDetector {		// Detects interchangeable objects: swapping two of them maps the initial state and the goals onto themselves
+private:
+	ParsedTask* task;
+	std::vector<bool> fixedObject;							// Constants and objects used in goals that are not a conjunction of literals
+	std::vector< std::vector<unsigned int> > facts;			// Initial-state facts and goal literals encoded as integer tuples
+	std::set< std::vector<unsigned int> > factSet;
+	std::vector< std::vector<unsigned int> > factsOfObject;	// Facts in which each object appears
+	std::vector< std::vector<unsigned int> > orbits;
+	std::vector<unsigned int> orbitOfObject;
+
+	void addFact(Fact &f);
+	void addGoalLiteral(Literal &l, bool negated);
+	void addGoal(Precondition &p);
+	void addGoal(GoalDescription &g);
+	void addFact(std::vector<unsigned int> &fact);
+	void fixObjects(Term &t);
+	void fixObjects(Literal &l);
+	void fixObjects(NumericExpression &e);
+	void fixObjects(GoalDescription &g);
+	void fixObjects(Precondition &p);
+	void fixObjects(Constraint &c);
+	void fixObjects(Metric &m);
+	std::vector<unsigned int> getSignature(unsigned int o);
+	bool isObjectPosition(std::vector<unsigned int> &fact, unsigned int pos);
+	bool areSymmetric(unsigned int o1, unsigned int o2);
+
+public:
+	void detectSymmetries(ParsedTask* task);
+	inline const std::vector< std::vector<unsigned int> >& getOrbits() { return orbits; }
+	inline unsigned int getOrbit(unsigned int objIndex) { return orbitOfObject[objIndex]; }	// MAX_UNSIGNED_INT if it has no symmetric objects
+	unsigned int getNumSymmetricObjects();
+};
+
+#endif
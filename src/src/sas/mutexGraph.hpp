@@ -3,6 +3,7 @@
 
 #include <unordered_map>
 #include <vector>
+#include "sasTask.hpp"
 
 class MutexGraph {
 private:
@@ -10,31 +11,14 @@ private:
     std::vector< std::vector<unsigned int> > mutexComponents;     // Set of mutually exclusive connected components
     std::vector<unsigned int> variableIndex;                      // Graph vertex -> real variable index
     std::unordered_map<unsigned int, unsigned int> vertexIndex;   // Real variable index -> graph vertex
-    std::vector< std::vector<unsigned int> > adjacent;            // Adjacent vertex for each vertex
-    void depthFirstSearch(unsigned int origin, std::vector<unsigned int> &component, bool* visited);
-    bool isMutuallyExclusive(const std::vector<unsigned int> &component);
-    inline bool isAdjacent(unsigned int i, unsigned int j) {
-        for (unsigned int a = 0; a < adjacent[i].size(); a++)
-            if (adjacent[i][a] == j) return true;
-        return false;
+    std::vector< std::pair<unsigned int, unsigned int> > edges;   // Mutex pairs added, in both directions
+    SASBitMatrix adjacent;                                        // Adjacency matrix, built from the edges when the graph is split
+    std::vector<unsigned int> degree;                             // Number of adjacent vertex of each vertex
+    void computeMutexComponent(unsigned int origin, const std::vector<bool> &covered, std::vector<unsigned int>* component);
+    inline bool isBetterCandidate(unsigned int v1, unsigned int v2, const std::vector<bool> &covered) {
+        if (covered[v1] != covered[v2]) return !covered[v1];      // Uncovered vertex first
+        return degree[v1] > degree[v2];
     }
-    void processNonMutexComponent(const std::vector<unsigned int> &component);
-    unsigned int highestDegreeVertex(const std::vector<unsigned int> &component);
-    void computeMutexSubcomponent(unsigned int v1, unsigned int v2, std::vector<unsigned int> &subcomponent);
-    void removeLinks(std::vector<unsigned int> &subcomponent);
-    inline void removeLink(unsigned int i, unsigned int j) {
-        for (unsigned int a = 0; a < adjacent[i].size(); a++)
-            if (adjacent[i][a] == j) {
-                adjacent[i].erase(adjacent[i].begin() + a);
-                break;
-            }
-        for (unsigned int a = 0; a < adjacent[j].size(); a++)
-            if (adjacent[j][a] == i) {
-                adjacent[j].erase(adjacent[j].begin() + a);
-                break;
-            }
-    }
-    void computeMutexComponent(unsigned int origin, std::vector<unsigned int>* component);
     
 public:
     MutexGraph();
@@ -43,7 +27,7 @@ public:
     void addAdjacent(unsigned int v1, unsigned int v2);
     void split();
     unsigned int numVariables();
-    void getVariable(unsigned int index, std::vector<unsigned int> &values, unsigned int noneOfThose);
+    void getVariable(unsigned int index, std::vector<unsigned int> &values);
 };
 
 #endif
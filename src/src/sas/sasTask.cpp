@@ -8,6 +8,8 @@
 #include <iostream>
 #include <limits>
 #include <time.h>
+#include <algorithm>
+#include <thread>
 #include "sasTask.hpp"
 #include "assert.h"
 using namespace std;
@@ -201,6 +203,367 @@ string SASNumericEffect::toString(vector<NumericVariable> *numVariables) {
 		exp.toString(numVariables) + ")";
 }
 
+/********************************************************/
+/* CLASS: SignatureSet                                  */
+/********************************************************/
+
+// Adds an index to the set
+void SignatureSet::add(unsigned int i) {
+	vector<unsigned int>::iterator it = lower_bound(items.begin(), items.end(), i);
+	if (it != items.end() && *it == i) return;
+	items.insert(it, i);
+	signature |= ((uint64_t) 1) << (i & 63);
+}
+
+// Checks if the given index is in the set
+bool SignatureSet::contains(unsigned int i) {
+	if ((signature & (((uint64_t) 1) << (i & 63))) == 0) return false;
+	return binary_search(items.begin(), items.end(), i);
+}
+
+// Checks if both sets have any common index
+bool SignatureSet::intersects(SignatureSet &s) {
+	if ((signature & s.signature) == 0) return false;
+	unsigned int i = 0, j = 0;
+	while (i < items.size() && j < s.items.size()) {
+		if (items[i] < s.items[j]) i++;
+		else if (items[i] > s.items[j]) j++;
+		else return true;
+	}
+	return false;
+}
+
+/********************************************************/
+/* CLASS: SASAction                                     */
+/********************************************************/
+
+// Adds the numeric variables in the expression to the set
+static void addNumericVariables(SASNumericExpression* e, SignatureSet &vars) {
+	if (e->type == 'V') vars.add(e->var);
+	else {
+		for (unsigned int i = 0; i < e->terms.size(); i++)
+			addNumericVariables(&(e->terms[i]), vars);
+	}
+}
+
+// Computes the sets of numeric variables read and modified by the action
+void SASAction::computeNumericVariableSets() {
+	for (unsigned int i = 0; i < startNumCond.size(); i++)
+		for (unsigned int j = 0; j < startNumCond[i].terms.size(); j++)
+			addNumericVariables(&(startNumCond[i].terms[j]), startNumRead);
+	for (unsigned int i = 0; i < endNumCond.size(); i++)
+		for (unsigned int j = 0; j < endNumCond[i].terms.size(); j++)
+			addNumericVariables(&(endNumCond[i].terms[j]), endNumRead);
+	for (unsigned int i = 0; i < startNumEff.size(); i++)
+		startNumWrite.add(startNumEff[i].var);
+	for (unsigned int i = 0; i < endNumEff.size(); i++)
+		endNumWrite.add(endNumEff[i].var);
+}
+
+/********************************************************/
+/* CLASS: SASActionTable                                */
+/********************************************************/
+
+// Appends the given conditions or effects as a new section
+static void addFacts(vector<SASCondition> &cond, vector<SASFact> &facts, vector<unsigned int> &offsets) {
+	for (unsigned int i = 0; i < cond.size(); i++) {
+		if (cond[i].var > 0xFFFF || cond[i].value > 0xFFFF) {
+			cout << "Too many variables or values for the action table." << endl;
+			exit(1);
+		}
+		facts.emplace_back(cond[i].var, cond[i].value);
+	}
+	offsets.push_back(facts.size());
+}
+
+// Removes all the actions from the table
+void SASActionTable::clear() {
+	facts.clear();
+	offsets.clear();
+	offsets.push_back(0);
+}
+
+// Adds the conditions and effects of the action to the table. Returns its row
+unsigned int SASActionTable::addAction(SASAction* a) {
+	unsigned int row = (offsets.size() - 1) / NUM_SECTIONS;
+	addFacts(a->startCond, facts, offsets);
+	addFacts(a->overCond, facts, offsets);
+	addFacts(a->endCond, facts, offsets);
+	addFacts(a->startEff, facts, offsets);
+	addFacts(a->endEff, facts, offsets);
+	return row;
+}
+
+/********************************************************/
+/* CLASS: SASFactNumbering                              */
+/********************************************************/
+
+// Numbers the variable-value codes given. Each variable gets a number for each shared value
+// and for each value in the range of its own values
+void SASFactNumbering::build(unsigned int numVariables, vector<uint32_t> &codes) {
+	vector<unsigned int> lastValue(numVariables, 0);
+	firstValue.assign(numVariables, MAX_UNSIGNED_INT);
+	for (unsigned int i = 0; i < codes.size(); i++) {
+		unsigned int var = codes[i] >> 16, value = codes[i] & 0xFFFF;
+		if (value >= SHARED_VALUES) {
+			if (value < firstValue[var]) firstValue[var] = value;
+			if (value > lastValue[var]) lastValue[var] = value;
+		}
+	}
+	row.resize(numVariables + 1);
+	row[0] = 0;
+	for (unsigned int i = 0; i < numVariables; i++) {
+		unsigned int size = SHARED_VALUES;
+		if (firstValue[i] == MAX_UNSIGNED_INT) firstValue[i] = SHARED_VALUES;
+		else size += lastValue[i] - firstValue[i] + 1;
+		row[i + 1] = row[i] + size;
+	}
+}
+
+// Returns the variable-value code with the given number
+uint32_t SASFactNumbering::getCode(unsigned int n) {
+	unsigned int var = upper_bound(row.begin(), row.end(), n) - row.begin() - 1;
+	unsigned int value = n - row[var];
+	if (value >= SHARED_VALUES) value += firstValue[var] - SHARED_VALUES;
+	return (var << 16) + value;
+}
+
+/********************************************************/
+/* CLASS: SASBitMatrix                                  */
+/********************************************************/
+
+// Builds the matrix with the given (row, column) cells set
+void SASBitMatrix::build(unsigned int size, vector<pair<unsigned int, unsigned int>> &cells) {
+	this->size = size;
+	dense = size <= DENSE_MATRIX_SIZE;
+	rowWords = (size + 63) >> 6;
+	bits.clear();
+	blockOffset.clear();
+	blockIndex.clear();
+	if (dense) {
+		bits.resize(size * rowWords, 0);
+		for (unsigned int i = 0; i < cells.size(); i++)
+			bits[cells[i].first * rowWords + (cells[i].second >> 6)] |= ((uint64_t) 1) << (cells[i].second & 63);
+		return;
+	}
+	sort(cells.begin(), cells.end());
+	blockOffset.assign(size + 1, 0);
+	for (unsigned int i = 0; i < cells.size(); i++) {
+		unsigned int r = cells[i].first, block = cells[i].second >> 6;
+		if (i == 0 || cells[i - 1].first != r || (cells[i - 1].second >> 6) != block) {	// New block
+			blockIndex.push_back(block);
+			bits.push_back(0);
+			blockOffset[r + 1]++;
+		}
+		bits.back() |= ((uint64_t) 1) << (cells[i].second & 63);
+	}
+	for (unsigned int i = 0; i < size; i++)
+		blockOffset[i + 1] += blockOffset[i];
+}
+
+// Checks if the cell (r, c) is set
+bool SASBitMatrix::get(unsigned int r, unsigned int c) {
+	if (dense) return (bits[r * rowWords + (c >> 6)] >> (c & 63)) & 1;
+	vector<unsigned int>::iterator first = blockIndex.begin() + blockOffset[r], last = blockIndex.begin() + blockOffset[r + 1];
+	vector<unsigned int>::iterator it = lower_bound(first, last, c >> 6);
+	if (it == last || *it != (c >> 6)) return false;
+	return (bits[it - blockIndex.begin()] >> (c & 63)) & 1;
+}
+
+// Returns the columns set in the given row, in increasing order
+void SASBitMatrix::getRow(unsigned int r, vector<unsigned int>* cols) {
+	cols->clear();
+	unsigned int first, last;
+	if (dense) {
+		first = r * rowWords;
+		last = first + rowWords;
+	} else {
+		first = blockOffset[r];
+		last = blockOffset[r + 1];
+	}
+	for (unsigned int i = first; i < last; i++) {
+		uint64_t word = bits[i];
+		unsigned int base = dense ? (i - first) << 6 : blockIndex[i] << 6;
+		while (word != 0) {
+			unsigned int b = __builtin_ctzll(word);
+			cols->push_back(base + b);
+			word &= word - 1;
+		}
+	}
+}
+
+/********************************************************/
+/* CLASS: SASActionIndex                                */
+/********************************************************/
+
+// Builds the compressed lists with the (var, value, action) entries added to the index.
+// Entries must have been added in increasing order of action index
+void SASActionIndex::build(unsigned int numVariables) {
+	vector<uint32_t> codes(pending.size());
+	for (unsigned int i = 0; i < pending.size(); i++)
+		codes[i] = pending[i].first;
+	facts.build(numVariables, codes);
+	unsigned int numSlots = facts.size();
+	vector<unsigned int> slots(pending.size());
+	vector<unsigned int> lastAction(numSlots, MAX_UNSIGNED_INT);
+	offsets.assign(numSlots + 1, 0);
+	for (unsigned int i = 0; i < pending.size(); i++) {
+		unsigned int slot = facts.getNumber(pending[i].first >> 16, pending[i].first & 0xFFFF);
+		if (lastAction[slot] == pending[i].second) {	// Duplicated entry
+			slots[i] = MAX_UNSIGNED_INT;
+		} else {
+			lastAction[slot] = pending[i].second;
+			slots[i] = slot;
+			offsets[slot + 1]++;
+		}
+	}
+	for (unsigned int i = 0; i < numSlots; i++)
+		offsets[i + 1] += offsets[i];
+	items.resize(offsets[numSlots]);
+	vector<unsigned int> next(offsets.begin(), offsets.end() - 1);
+	for (unsigned int i = 0; i < pending.size(); i++) {
+		if (slots[i] != MAX_UNSIGNED_INT)
+			items[next[slots[i]]++] = pending[i].second;
+	}
+	vector<pair<uint32_t, unsigned int>>().swap(pending);
+}
+
+/********************************************************/
+/* CLASS: SASNumericCode                                */
+/********************************************************/
+
+// Appends the postfix code of the expression, whose result is left at the given stack depth.
+// Returns false if the expression cannot be compiled
+bool SASNumericCode::compileExpression(SASNumericExpression* e, unsigned int depth) {
+	if (depth >= STACK_SIZE) return false;
+	unsigned int start = code.size();
+	switch (e->type) {
+	case 'N':	code.emplace_back('N', 0, e->value);	return true;
+	case 'V':	code.emplace_back('V', e->var, 0);		return true;
+	case 'D':	code.emplace_back('D', 0, 0);			return true;
+	case '+':
+	case '-':
+	case '*':
+	case '/':
+		if (e->terms.empty() || !compileExpression(&(e->terms[0]), depth)) return false;
+		for (unsigned int i = 1; i < e->terms.size(); i++) {
+			if (!compileExpression(&(e->terms[i]), depth + 1)) return false;
+			code.emplace_back(e->type, 0, 0);
+		}
+		foldConstants(start);
+		return true;
+	default:	return false;						// #t is left to the interpreter, which reports it
+	}
+}
+
+// Appends the postfix code of the metric, whose result is left at the given stack depth.
+// The makespan is read as the duration. Returns false if the metric cannot be compiled
+bool SASNumericCode::compileMetric(SASMetric* m, unsigned int depth) {
+	if (depth >= STACK_SIZE) return false;
+	unsigned int start = code.size();
+	switch (m->type) {
+	case 'N':	code.emplace_back('N', 0, m->value);	return true;
+	case 'T':	code.emplace_back('D', 0, 0);			return true;
+	case 'V':	code.emplace_back('N', 0, 0);			return true;
+	case 'F':
+		if (m->index > 0xFFFF) return false;
+		code.emplace_back('V', m->index, 0);
+		return true;
+	case '+':
+	case '-':
+	case '*':
+	case '/':
+		if (m->terms.empty() || !compileMetric(&(m->terms[0]), depth)) return false;
+		if (m->terms.size() == 1 && m->type == '-') code.emplace_back('M', 0, 0);
+		for (unsigned int i = 1; i < m->terms.size(); i++) {
+			if (!compileMetric(&(m->terms[i]), depth + 1)) return false;
+			code.emplace_back(m->type, 0, 0);
+		}
+		foldConstants(start);
+		return true;
+	default:	return false;
+	}
+}
+
+// Replaces the code from the given instruction on by its value if it does not depend on the state or the duration.
+// The value is computed by the same evaluation loop, so the result is exactly the one obtained at run time
+void SASNumericCode::foldConstants(unsigned int start) {
+	if (code.size() - start == 1) return;
+	for (unsigned int i = start; i < code.size(); i++)
+		if (code[i].op == 'V' || code[i].op == 'D') return;
+	code.emplace_back('R', 0, 0);
+	float value = evaluate(start, nullptr, 0);
+	code.erase(code.begin() + start, code.end());
+	code.emplace_back('N', 0, value);
+}
+
+// Terminates the program that begins at the given instruction. Returns its first instruction,
+// or MAX_UNSIGNED_INT if it could not be compiled
+unsigned int SASNumericCode::finishProgram(unsigned int start, bool compiled) {
+	if (!compiled) {
+		code.erase(code.begin() + start, code.end());
+		return MAX_UNSIGNED_INT;
+	}
+	code.emplace_back('R', 0, 0);
+	return start;
+}
+
+// Evaluates the program in the given numeric state
+float SASNumericCode::evaluate(unsigned int program, float* s, float duration) {
+	float stack[STACK_SIZE];
+	float* top = stack;								// First free position of the stack
+	for (const SASNumericInstruction* ins = code.data() + program; ; ins++) {
+		switch (ins->op) {
+		case 'N':	*top++ = ins->value;		break;
+		case 'V':	*top++ = s[ins->var];		break;
+		case 'D':	*top++ = duration;			break;
+		case 'M':	top[-1] = -top[-1];			break;
+		case '+':	top--;	top[-1] += *top;	break;
+		case '-':	top--;	top[-1] -= *top;	break;
+		case '*':	top--;	top[-1] *= *top;	break;
+		case '/':	top--;	top[-1] /= *top;	break;
+		default:	return stack[0];
+		}
+	}
+}
+
+// Evaluates the program in several numeric states at once. Each stack position keeps a row with one value per state
+void SASNumericCode::evaluate(unsigned int program, float** states, unsigned int numStates, float duration, float* results) {
+	vector<float> stack(STACK_SIZE * numStates);
+	float* top = stack.data();						// First free row of the stack
+	for (const SASNumericInstruction* ins = code.data() + program; ins->op != 'R'; ins++) {
+		float* prev = top - numStates;
+		switch (ins->op) {
+		case 'N':
+			for (unsigned int i = 0; i < numStates; i++) top[i] = ins->value;
+			top += numStates;
+			break;
+		case 'V':
+			for (unsigned int i = 0; i < numStates; i++) top[i] = states[i][ins->var];
+			top += numStates;
+			break;
+		case 'D':
+			for (unsigned int i = 0; i < numStates; i++) top[i] = duration;
+			top += numStates;
+			break;
+		case 'M':
+			for (unsigned int i = 0; i < numStates; i++) prev[i] = -prev[i];
+			break;
+		default:
+			top = prev;
+			prev -= numStates;
+			switch (ins->op) {
+			case '+':	for (unsigned int i = 0; i < numStates; i++) prev[i] += top[i];	break;
+			case '-':	for (unsigned int i = 0; i < numStates; i++) prev[i] -= top[i];	break;
+			case '*':	for (unsigned int i = 0; i < numStates; i++) prev[i] *= top[i];	break;
+			default:	for (unsigned int i = 0; i < numStates; i++) prev[i] /= top[i];	break;
+			}
+		}
+	}
+	for (unsigned int i = 0; i < numStates; i++)
+		results[i] = stack[i];
+}
+
 /********************************************************/
 /* CLASS: SASTask                                       */
 /********************************************************/
@@ -210,24 +573,12 @@ SASTask::SASTask() {
 	createNewValue("<true>", FICTITIOUS_FUNCTION);
 	createNewValue("<false>", FICTITIOUS_FUNCTION);
 	createNewValue("<undefined>", FICTITIOUS_FUNCTION);
-	requirers = nullptr;
-	producers = nullptr;
 	numGoalsInPlateau = 1;
+	permanentMutexActionsFound = false;
+	metricProgram = MAX_UNSIGNED_INT;
 }
 
 SASTask::~SASTask() {
-	if (requirers != nullptr) {
-		for (unsigned int i = 0; i < variables.size(); i++) {
-			delete[] requirers[i];
-		}
-		delete[] requirers;
-	}
-	if (producers != nullptr) {
-		for (unsigned int i = 0; i < variables.size(); i++) {
-			delete[] producers[i];
-		}
-		delete[] producers;
-	}
 	delete[] initialState;
 	delete[] numInitialState;
 	if (staticNumFunctions != nullptr) delete[] staticNumFunctions;
@@ -235,25 +586,25 @@ SASTask::~SASTask() {
 
 // Adds a mutex relationship between (var1, value1) and (var2, value2)
 void SASTask::addMutex(unsigned int var1, unsigned int value1, unsigned int var2, unsigned int value2) {
-    mutex[getMutexCode(var1, value1, var2, value2)] = true;
-    mutex[getMutexCode(var2, value2, var1, value1)] = true;
+    mutexPairs.emplace_back(getVariableValueCode(var1, value1), getVariableValueCode(var2, value2));
 	//cout << "Mutex added: " << variables[var1].name << "=" << values[value1].name << " and " <<
 	//	variables[var2].name << "=" << values[value2].name << endl;
 }
 
 // Checks if (var1, value1) and (var2, value2) are mutex
 bool SASTask::isMutex(unsigned int var1, unsigned int value1, unsigned int var2, unsigned int value2) {
-    return mutex.find(getMutexCode(var1, value1, var2, value2)) != mutex.end();
+	unsigned int n1 = mutexFacts.getNumber(var1, value1), n2 = mutexFacts.getNumber(var2, value2);
+	return n1 != MAX_UNSIGNED_INT && n2 != MAX_UNSIGNED_INT && mutex.get(n1, n2);
 }
 
+// Checks if (var2, value2) cannot be reached once (var1, value1) holds, being both mutex
 bool SASTask::isPermanentMutex(unsigned int var1, unsigned int value1, unsigned int var2, unsigned int value2) {
-    return permanentMutex.find(getMutexCode(var1, value1, var2, value2)) != mutex.end();
+	unsigned int n1 = mutexFacts.getNumber(var1, value1), n2 = mutexFacts.getNumber(var2, value2);
+	return n1 != MAX_UNSIGNED_INT && n2 != MAX_UNSIGNED_INT && permanentMutex.get(n1, n2);
 }
 
 bool SASTask::isPermanentMutex(SASAction* a1, SASAction* a2) {
-	uint64_t n = a1->index;
-	n = (n << 32) + a2->index;
-	return permanentMutexActions.find(n) != permanentMutexActions.end();
+	return a1->permanentMutexActions.contains(a2->index);
 }
 
 // Adds a new variable
@@ -341,156 +692,242 @@ void SASTask::computeInitialState() {
 	}
 }
 
+// Adds the given conditions or effects of an action to a requirers/producers index
+static void addToIndex(SASActionIndex &index, vector<SASCondition> &cond, unsigned int action,
+		unsigned int numVariables, unsigned int numValues) {
+	for (unsigned int i = 0; i < cond.size(); i++) {
+		if (cond[i].var < numVariables && cond[i].value < numValues)
+			index.add(cond[i].var, cond[i].value, action);
+	}
+}
+
 // Computes the list of actions that requires a (= var value)
 void SASTask::computeRequirers() {
-	requirers = new vector<SASAction*>*[variables.size()];
-	for (unsigned int i = 0; i < variables.size(); i++) {
-		requirers[i] = new vector<SASAction*>[values.size()];
-	}
 	unsigned int numActions = actions.size();
 	for (unsigned int i = 0; i < numActions; i++) {
 		SASAction* a = &(actions[i]);
-		for (unsigned int j = 0; j < a->startCond.size(); j++)
-			addToRequirers(a->startCond[j].var, a->startCond[j].value, a);
-		for (unsigned int j = 0; j < a->overCond.size(); j++)
-			addToRequirers(a->overCond[j].var, a->overCond[j].value, a);
-		for (unsigned int j = 0; j < a->endCond.size(); j++)
-			addToRequirers(a->endCond[j].var, a->endCond[j].value, a);
+		addToIndex(requirers, a->startCond, i, variables.size(), values.size());
+		addToIndex(requirers, a->overCond, i, variables.size(), values.size());
+		addToIndex(requirers, a->endCond, i, variables.size(), values.size());
 		if (a->startCond.empty() && a->overCond.empty() && a->endCond.empty()) {
 			actionsWithoutConditions.push_back(a);
 		}
 	}
-}
-
-// Adds a requirer, checking for no duplicates
-void SASTask::addToRequirers(TVariable v, TValue val, SASAction* a) {
-	if (v >= variables.size() || val >= values.size()) return;
-	std::vector<SASAction*> &req = requirers[v][val];
-	for (unsigned int i = 0; i < req.size(); i++) {
-		if (req[i] == a) return;
-	}
-	req.push_back(a);
+	requirers.build(variables.size());
 }
 
 // Computes the list of actions that produces (= var value)
 void SASTask::computeProducers() {
-	producers = new vector<SASAction*>*[variables.size()];
-	for (unsigned int i = 0; i < variables.size(); i++) {
-		producers[i] = new vector<SASAction*>[values.size()];
-	}
 	unsigned int numActions = actions.size();
 	for (unsigned int i = 0; i < numActions; i++) {
 		SASAction* a = &(actions[i]);
-		for (unsigned int j = 0; j < a->startEff.size(); j++)
-			addToProducers(a->startEff[j].var, a->startEff[j].value, a);
-		for (unsigned int j = 0; j < a->endEff.size(); j++)
-			addToProducers(a->endEff[j].var, a->endEff[j].value, a);
-	}
-}
-
-void SASTask::computeMutexWithVarValues() {
-	uint32_t vv1, vv2;
-	std::unordered_map<uint64_t, bool>::const_iterator got = mutex.begin();
-	std::unordered_map<uint32_t, std::vector<uint32_t>*>::const_iterator it;
-	for (; got != mutex.end(); ++got) {
-		uint64_t n = got->first;
-		vv2 = n & 0xFFFFFFFF;
-		vv1 = (uint32_t) (n >> 32);
-		it = mutexWithVarValue.find(vv1);
-		if (it == mutexWithVarValue.end()) {
-			std::vector<uint32_t>* item = new std::vector<uint32_t>();
-			item->push_back(vv2);
-			mutexWithVarValue[vv1] = item;
-		} else {
-			it->second->push_back(vv2);
-		}
+		addToIndex(producers, a->startEff, i, variables.size(), values.size());
+		addToIndex(producers, a->endEff, i, variables.size(), values.size());
 	}
+	producers.build(variables.size());
 }
 
-void SASTask::checkEffectReached(SASCondition* c, std::unordered_map<TVarValue,bool>* goals,
-		std::unordered_map<TVarValue, bool>* visitedVarValue, std::vector<TVarValue>* state) {
-	TVarValue code = getVariableValueCode(c->var, c->value);
-	goals->erase(code);
-	if (visitedVarValue->find(code) == visitedVarValue->end()) {
-		(*visitedVarValue)[code] = true;
-		state->push_back(code);
+// Builds the mutex matrix with the mutex pairs added
+void SASTask::computeMutexMatrix() {
+	vector<uint32_t> codes;
+	for (unsigned int i = 0; i < mutexPairs.size(); i++) {
+		codes.push_back(mutexPairs[i].first);
+		codes.push_back(mutexPairs[i].second);
+	}
+	for (unsigned int i = 0; i < actions.size(); i++) {	// Facts reached in the computation of the permanent mutex
+		for (unsigned int j = 0; j < actions[i].startEff.size(); j++)
+			codes.push_back(getVariableValueCode(actions[i].startEff[j].var, actions[i].startEff[j].value));
+		for (unsigned int j = 0; j < actions[i].endEff.size(); j++)
+			codes.push_back(getVariableValueCode(actions[i].endEff[j].var, actions[i].endEff[j].value));
+	}
+	mutexFacts.build(variables.size(), codes);
+	vector<pair<unsigned int, unsigned int>> cells;
+	for (unsigned int i = 0; i < mutexPairs.size(); i++) {
+		unsigned int n1 = mutexFacts.getNumber(getVariableIndex(mutexPairs[i].first), getValueIndex(mutexPairs[i].first));
+		unsigned int n2 = mutexFacts.getNumber(getVariableIndex(mutexPairs[i].second), getValueIndex(mutexPairs[i].second));
+		cells.emplace_back(n1, n2);
+		cells.emplace_back(n2, n1);
 	}
+	mutex.build(mutexFacts.size(), cells);
+	vector<pair<TVarValue, TVarValue>>().swap(mutexPairs);
 }
 
-void SASTask::checkReachability(TVarValue vv, std::unordered_map<TVarValue,bool>* goals) {
-	/*
-	cout << "Checking if " << variables[getVariableIndex(vv)].name << "=" <<
-			values[getValueIndex(vv)].name << " is permanent mutex with:" << endl;
-	for (std::unordered_map<TVarValue,bool>::const_iterator itg = goals->begin(); itg != goals->end(); ++itg)
-		cout << " " << variables[getVariableIndex(itg->first)].name << "=" << values[getValueIndex(itg->first)].name << endl;
-	*/
-	unsigned int numActions = actions.size();
-	bool visited[numActions];
-	for (unsigned int i = 0; i < numActions; i++) visited[i] = false;
-	std::vector<TVarValue> state;
-	std::unordered_map<TVarValue, bool> visitedVarValue;
-	state.push_back(vv);
-	visitedVarValue[vv] = true;
-	unsigned int start = 0;
-	while (start < state.size() && !goals->empty()) {
-		TVariable v = getVariableIndex(state[start]);
-		TValue value = getValueIndex(state[start]);
-		start++;
-		std::vector<SASAction*> &req = requirers[v][value];
-		//cout << variables[v].name << "=" << values[value].name << endl;
-		for (unsigned int i = 0; i < req.size(); i++) {
-			SASAction *a = req[i];
-			if (!visited[a->index]) {
-				visited[a->index] = true;
-				//cout << " - " << a->name << endl;
-				for (unsigned int j = 0; j < a->startEff.size(); j++)
-					checkEffectReached(&(a->startEff[j]), goals, &visitedVarValue, &state);
-				for (unsigned int j = 0; j < a->endEff.size(); j++)
-					checkEffectReached(&(a->endEff[j]), goals, &visitedVarValue, &state);
-			}
+// Adds the facts produced by the effects that have not been reached yet and removes them from the goals
+void SASTask::checkEffectsReached(std::vector<SASCondition> &eff, std::vector<bool> &reached, std::vector<bool> &goal,
+		unsigned int* remainingGoals, std::vector<unsigned int>* state) {
+	for (unsigned int i = 0; i < eff.size(); i++) {
+		unsigned int n = mutexFacts.getNumber(eff[i].var, eff[i].value);
+		if (goal[n]) {
+			goal[n] = false;
+			(*remainingGoals)--;
+		}
+		if (!reached[n]) {
+			reached[n] = true;
+			state->push_back(n);
 		}
 	}
 }
 
-void SASTask::computePermanentMutex() {
-    //clock_t tini = clock();
-    computeMutexWithVarValues();
-	std::unordered_map<uint32_t, std::vector<uint32_t>*>::const_iterator it;
-	std::unordered_map<uint32_t,bool>::const_iterator ug;
-	for (it = mutexWithVarValue.begin(); it != mutexWithVarValue.end(); ++it) {
-		//cout << it->second->size() << endl;
-		std::unordered_map<uint32_t,bool> goals;
-		for (unsigned int i = 0; i < it->second->size(); i++) {
-			goals[it->second->at(i)] = true;
+// For the facts first, first + step, first + 2*step..., finds the mutex facts that cannot be reached from them.
+// The resulting pairs are permanent mutex
+void SASTask::computePermanentMutexFacts(unsigned int first, unsigned int step, std::vector<std::pair<unsigned int, unsigned int>>* cells) {
+	unsigned int numFacts = mutexFacts.size();
+	std::vector<bool> reached(numFacts, false), goal(numFacts, false), visited(actions.size(), false);
+	std::vector<unsigned int> state, goals, visitedActions;
+	for (unsigned int n = first; n < numFacts; n += step) {
+		mutex.getRow(n, &goals);
+		if (goals.empty()) continue;
+		unsigned int remainingGoals = goals.size();
+		for (unsigned int i = 0; i < goals.size(); i++) goal[goals[i]] = true;
+		state.clear();
+		state.push_back(n);
+		reached[n] = true;
+		unsigned int start = 0;
+		while (start < state.size() && remainingGoals > 0) {
+			uint32_t code = mutexFacts.getCode(state[start++]);
+			SASActionList req = getRequirers(getVariableIndex(code), getValueIndex(code));
+			for (unsigned int i = 0; i < req.size(); i++) {
+				SASAction *a = req[i];
+				if (!visited[a->index]) {
+					visited[a->index] = true;
+					visitedActions.push_back(a->index);
+					checkEffectsReached(a->startEff, reached, goal, &remainingGoals, &state);
+					checkEffectsReached(a->endEff, reached, goal, &remainingGoals, &state);
+				}
+			}
 		}
-		checkReachability(it->first, &goals);
-		for (ug = goals.begin(); ug != goals.end(); ++ug) {
-			TMutex code = (((TMutex)it->first) << 32) + ug->first;
-			permanentMutex[code] = true;
+		for (unsigned int i = 0; i < goals.size(); i++) {
+			if (goal[goals[i]]) {
+				cells->emplace_back(n, goals[i]);
+				goal[goals[i]] = false;
+			}
 		}
+		for (unsigned int i = 0; i < state.size(); i++) reached[state[i]] = false;
+		for (unsigned int i = 0; i < visitedActions.size(); i++) visited[visitedActions[i]] = false;
+		visitedActions.clear();
 	}
-	if (permanentMutex.size() > 0) {
-		unsigned int numActions = actions.size();
-		for (unsigned int i = 0; i < numActions - 1; i++) {
-			SASAction* a1 = &(actions[i]);
-			for (unsigned int j = i + 1; j < numActions; j++) {
-				if (checkActionMutex(a1, &(actions[j]))) {
-					//cout << a1->name << " <- mutex -> " << actions[j].name << endl;
-					uint64_t n = a1->index;
-					n = (n << 32) + actions[j].index;
-					permanentMutexActions[n] = true;
-					n = actions[j].index;
-					n = (n << 32) + a1->index;
-					permanentMutexActions[n] = true;
+}
+
+// Adds to candidates the actions (with index greater than a1) that require a fact that is permanent mutex with an effect of a1
+void SASTask::addPermanentMutexCandidates(SASAction* a1, std::vector<SASCondition> &eff, std::vector<unsigned int> &stamp,
+		std::vector<unsigned int>* candidates) {
+	std::vector<unsigned int> row;
+	for (unsigned int i = 0; i < eff.size(); i++) {
+		unsigned int n = mutexFacts.getNumber(eff[i].var, eff[i].value);
+		permanentMutex.getRow(n, &row);
+		for (unsigned int j = 0; j < row.size(); j++) {
+			uint32_t code = mutexFacts.getCode(row[j]);
+			SASActionList req = getRequirers(getVariableIndex(code), getValueIndex(code));
+			for (unsigned int k = 0; k < req.size(); k++) {
+				unsigned int a2 = req[k]->index;
+				if (a2 > a1->index && stamp[a2] != a1->index) {
+					stamp[a2] = a1->index;
+					candidates->push_back(a2);
 				}
 			}
 		}
 	}
+}
+
+// For the actions first, first + step, first + 2*step..., finds the actions (with a greater index) that are permanent mutex with them
+void SASTask::computePermanentMutexActions(unsigned int first, unsigned int step, std::vector<std::pair<unsigned int, unsigned int>>* pairs) {
+	unsigned int numActions = actions.size();
+	std::vector<unsigned int> stamp(numActions, MAX_UNSIGNED_INT), candidates;
+	for (unsigned int i = first; i < numActions; i += step) {
+		SASAction* a1 = &(actions[i]);
+		candidates.clear();
+		addPermanentMutexCandidates(a1, a1->startEff, stamp, &candidates);
+		addPermanentMutexCandidates(a1, a1->endEff, stamp, &candidates);
+		for (unsigned int j = 0; j < candidates.size(); j++) {	// a1 cannot be executed before the candidate. Check the opposite ordering
+			if (checkActionOrdering(&(actions[candidates[j]]), a1))
+				pairs->emplace_back(i, candidates[j]);
+		}
+	}
+}
+
+void SASTask::computePermanentMutex() {
+    //clock_t tini = clock();
+    computeMutexMatrix();
+	unsigned int numThreads = getNumThreads(mutexFacts.size());
+	std::vector<std::vector<std::pair<unsigned int, unsigned int>>> results(numThreads);
+	std::vector<thread> threads;
+	for (unsigned int t = 1; t < numThreads; t++)
+		threads.emplace_back(&SASTask::computePermanentMutexFacts, this, t, numThreads, &(results[t]));
+	computePermanentMutexFacts(0, numThreads, &(results[0]));
+	for (unsigned int t = 0; t < threads.size(); t++) threads[t].join();
+	std::vector<std::pair<unsigned int, unsigned int>> cells;
+	for (unsigned int t = 0; t < numThreads; t++)
+		cells.insert(cells.end(), results[t].begin(), results[t].end());
+	permanentMutex.build(mutexFacts.size(), cells);
+	if (!cells.empty()) {
+		numThreads = getNumThreads(actions.size());
+		results.clear();
+		results.resize(numThreads);
+		threads.clear();
+		for (unsigned int t = 1; t < numThreads; t++)
+			threads.emplace_back(&SASTask::computePermanentMutexActions, this, t, numThreads, &(results[t]));
+		computePermanentMutexActions(0, numThreads, &(results[0]));
+		for (unsigned int t = 0; t < threads.size(); t++) threads[t].join();
+		for (unsigned int t = 0; t < numThreads; t++) {
+			for (unsigned int i = 0; i < results[t].size(); i++) {
+				SASAction* a1 = &(actions[results[t][i].first]);
+				SASAction* a2 = &(actions[results[t][i].second]);
+				//cout << a1->name << " <- mutex -> " << a2->name << endl;
+				a1->permanentMutexActions.add(a2->index);
+				a2->permanentMutexActions.add(a1->index);
+				permanentMutexActionsFound = true;
+			}
+		}
+	}
 	//cout << (float) (((int) (1000 * (clock() - tini)/(float) CLOCKS_PER_SEC))/1000.0) << " sec." << endl;
 }
 
-bool SASTask::checkActionMutex(SASAction* a1, SASAction* a2) {
-	return checkActionOrdering(a1, a2) && checkActionOrdering(a2, a1);
+// Computes the sets of numeric variables read and modified by the actions and goals
+void SASTask::computeNumericVariableSets() {
+	for (unsigned int i = 0; i < actions.size(); i++)
+		actions[i].computeNumericVariableSets();
+	for (unsigned int i = 0; i < goals.size(); i++)
+		goals[i].computeNumericVariableSets();
+}
+
+// Builds the compiled action table with the conditions and effects of the actions and goals, and compiles their numeric expressions
+void SASTask::compileActionTable() {
+	actionTable.clear();
+	for (unsigned int i = 0; i < actions.size(); i++)
+		actions[i].tableRow = actionTable.addAction(&(actions[i]));
+	for (unsigned int i = 0; i < goals.size(); i++)
+		goals[i].tableRow = actionTable.addAction(&(goals[i]));
+	compileNumericPrograms();
+}
+
+// Compiles the terms of the numeric conditions
+static void compileNumericConditions(vector<SASNumericCondition> &cond, SASNumericCode &code) {
+	for (unsigned int i = 0; i < cond.size(); i++)
+		for (unsigned int j = 0; j < cond[i].terms.size(); j++)
+			cond[i].terms[j].program = code.addExpression(&(cond[i].terms[j]));
+}
+
+// Compiles the duration, numeric conditions and numeric effects of the action
+void SASTask::compileNumericExpressions(SASAction* a) {
+	for (unsigned int i = 0; i < a->duration.size(); i++)
+		a->duration[i].exp.program = numericCode.addExpression(&(a->duration[i].exp));
+	compileNumericConditions(a->startNumCond, numericCode);
+	compileNumericConditions(a->overNumCond, numericCode);
+	compileNumericConditions(a->endNumCond, numericCode);
+	for (unsigned int i = 0; i < a->startNumEff.size(); i++)
+		a->startNumEff[i].exp.program = numericCode.addExpression(&(a->startNumEff[i].exp));
+	for (unsigned int i = 0; i < a->endNumEff.size(); i++)
+		a->endNumEff[i].exp.program = numericCode.addExpression(&(a->endNumEff[i].exp));
+}
+
+// Compiles the numeric expressions of the actions and goals, and the metric
+void SASTask::compileNumericPrograms() {
+	numericCode.clear();
+	for (unsigned int i = 0; i < actions.size(); i++)
+		compileNumericExpressions(&(actions[i]));
+	for (unsigned int i = 0; i < goals.size(); i++)
+		compileNumericExpressions(&(goals[i]));
+	metricProgram = metricType == 'X' ? MAX_UNSIGNED_INT : numericCode.addMetric(&metric);
 }
 
 bool SASTask::checkActionOrdering(SASAction* a1, SASAction* a2) {
@@ -535,15 +972,6 @@ bool SASTask::checkActionOrdering(SASAction* a1, SASAction* a2) {
 	return false;
 }
 
-// Adds a producer, checking for no duplicates
-void SASTask::addToProducers(TVariable v, TValue val, SASAction* a) {
-	if (v >= variables.size() || val >= values.size()) return;
-	std::vector<SASAction*> &prod = producers[v][val];
-	for (unsigned int i = 0; i < prod.size(); i++) {
-		if (prod[i] == a) return;
-	}
-	prod.push_back(a);
-}
 
 // Computes the cost of the actions according to the metric (if possible)
 // The cost of an action cannot be computed in the following cases:
@@ -656,11 +1084,11 @@ void SASTask::computeActionCost(SASAction* a, bool* variablesOnMetric) {
 
 // Computes the cost of aplying an action in a given state
 float SASTask::computeActionCost(SASAction* a, float* numState, float makespan) {
-	float startMetricValue = evaluateMetric(&metric, numState, makespan), 
+	float startMetricValue = evaluateMetric(numState, makespan), 
 		endMetricValue,
 		dur = a->fixedDurationValue[0];
 	if (a->startNumEff.empty() && a->endNumEff.empty()) {
-		endMetricValue = evaluateMetric(&metric, numState, makespan + dur);
+		endMetricValue = evaluateMetric(numState, makespan + dur);
 	}
 	else {
 		unsigned int numV = numVariables.size();
@@ -674,7 +1102,7 @@ float SASTask::computeActionCost(SASAction* a, float* numState, float makespan)
 		for (unsigned int i = 0; i < a->endNumEff.size(); i++) {
 			updateNumericState(newState, &(a->endNumEff[i]), dur);
 		}
-		endMetricValue = evaluateMetric(&metric, newState, makespan + dur);
+		endMetricValue = evaluateMetric(newState, makespan + dur);
 		delete[] newState;
 	}
 	return endMetricValue - startMetricValue;
@@ -737,8 +1165,10 @@ bool SASTask::holdsNumericCondition(SASNumericCondition& cond, float *s, float d
 	return false;
 }
 
-// Evaluates a numeric expression in a given state and with the given action duration
+// Evaluates a numeric expression in a given state and with the given action duration.
+// Compiled expressions run their program; the others are interpreted
 float SASTask::evaluateNumericExpression(SASNumericExpression* e, float *s, float duration) {
+	if (e->program != MAX_UNSIGNED_INT) return numericCode.evaluate(e->program, s, duration);
 	if (e->type == 'N') return e->value;			// NUMBER
 	if (e->type == 'V') return s[e->var];			// VAR
 	if (e->type == 'D') return duration;
@@ -758,6 +1188,15 @@ float SASTask::evaluateNumericExpression(SASNumericExpression* e, float *s, floa
 	return res;
 }
 
+// Evaluates a numeric expression in several states at once, with the given action duration
+void SASTask::evaluateNumericExpression(SASNumericExpression* e, float** states, unsigned int numStates, float duration, float* results) {
+	if (e->program != MAX_UNSIGNED_INT) numericCode.evaluate(e->program, states, numStates, duration, results);
+	else {
+		for (unsigned int i = 0; i < numStates; i++)
+			results[i] = evaluateNumericExpression(e, states[i], duration);
+	}
+}
+
 // Calculates the metric cost in the given state and with the given plan duration
 float SASTask::evaluateMetric(SASMetric* m, float* numState, float makespan) {
 	switch (m->type) {
@@ -9,6 +9,8 @@
 #include "../utils/utils.hpp"
 
 #define FICTITIOUS_FUNCTION		999999U
+#define SHARED_VALUES			3		// Values <true>, <false> and <undefined> are shared by many variables
+#define DENSE_MATRIX_SIZE		4096	// Bit matrices up to this size are stored in dense form
 
 class SASValue {
 public:
@@ -54,6 +56,9 @@ public:
 	float value;								// if type == 'N'
 	uint16_t var;
 	std::vector<SASNumericExpression> terms;	// if type == '+' | '-' | '*' | '/' | '#'
+	unsigned int program;						// First instruction of the compiled expression (MAX_UNSIGNED_INT if not compiled)
+
+	SASNumericExpression() : program(MAX_UNSIGNED_INT) {}
     std::string toString(std::vector<NumericVariable> *numVariables);
 };
 
@@ -103,6 +108,18 @@ public:
     SASGoalDescription preference;
 };
 
+class SignatureSet {						// Sorted set of indexes with a 64-bit signature for fast intersection tests
+public:
+	uint64_t signature;						// Bit (i % 64) is set if index i is in the set
+	std::vector<unsigned int> items;		// Indexes in the set, in increasing order
+
+	SignatureSet() : signature(0) {}
+	void add(unsigned int i);
+	bool contains(unsigned int i);
+	bool intersects(SignatureSet &s);
+	inline bool empty() { return items.empty(); }
+};
+
 class SASAction {
 public:
 	unsigned int index;
@@ -125,7 +142,14 @@ public:
 	std::vector<float> fixedDurationValue;	// Fixed duration of the action (only if fixedDuration)
 	bool fixedCost;							// True if the cost of the action does not depend on the state
 	float fixedCostValue;					// Fixed cost of the action according to the metric (only if fixedCost)
+	SignatureSet startNumRead;				// Numeric variables in the at-start numeric conditions
+	SignatureSet endNumRead;				// Numeric variables in the at-end numeric conditions
+	SignatureSet startNumWrite;				// Numeric variables modified by the at-start numeric effects
+	SignatureSet endNumWrite;				// Numeric variables modified by the at-end numeric effects
+	SignatureSet permanentMutexActions;		// Indexes of the actions that are permanent mutex with this one
+	unsigned int tableRow;					// Row of the action in the compiled action table
 
+	void computeNumericVariableSets();
 	void setGoalCost() {					// Sets the cost and duration of a ficttious goal action
 		fixedDuration = true;
 		fixedDurationValue.push_back(EPSILON);
@@ -134,6 +158,102 @@ public:
 	}
 };
 
+class SASFact {							// Compact (variable, value) pair
+public:
+	uint16_t var;
+	uint16_t value;
+	SASFact(unsigned int var, unsigned int value) : var(var), value(value) {}
+};
+
+class SASActionTable {					// Read-only copy of the propositional conditions and effects of the actions in contiguous arrays
+public:
+	static const unsigned int START_COND = 0;
+	static const unsigned int OVER_COND = 1;
+	static const unsigned int END_COND = 2;
+	static const unsigned int START_EFF = 3;
+	static const unsigned int END_EFF = 4;
+	static const unsigned int NUM_SECTIONS = 5;
+	std::vector<SASFact> facts;				// Conditions and effects of every action, grouped by action and section
+	std::vector<unsigned int> offsets;		// First fact of each section of each action, plus a final sentinel
+
+	SASActionTable() { offsets.push_back(0); }
+	void clear();
+	unsigned int addAction(SASAction* a);
+	inline unsigned int begin(unsigned int row, unsigned int section) { return offsets[row * NUM_SECTIONS + section]; }
+	inline unsigned int end(unsigned int row, unsigned int section) { return offsets[row * NUM_SECTIONS + section + 1]; }
+};
+
+class SASActionList {					// View of a list of actions stored in an SASActionIndex
+public:
+	const unsigned int* items;				// Action indexes
+	unsigned int count;
+	SASAction* actions;						// Array of actions the indexes refer to
+
+	SASActionList(const unsigned int* items, unsigned int count, SASAction* actions) : items(items), count(count), actions(actions) {}
+	inline unsigned int size() { return count; }
+	inline bool empty() { return count == 0; }
+	inline SASAction* operator[](unsigned int i) { return actions + items[i]; }
+};
+
+class SASFactNumbering {				// Consecutive numbers for the (variable, value) pairs of a task
+friend class SASTaskCache;
+private:
+	std::vector<unsigned int> row;			// First number of each variable, plus a final sentinel
+	std::vector<unsigned int> firstValue;	// First non-shared value of each variable
+
+public:
+	void build(unsigned int numVariables, std::vector<uint32_t> &codes);
+	inline unsigned int size() { return row.empty() ? 0 : row.back(); }
+	inline unsigned int getNumber(unsigned int var, unsigned int value) {	// MAX_UNSIGNED_INT if the pair has no number
+		if (var >= firstValue.size()) return MAX_UNSIGNED_INT;
+		unsigned int n = value;
+		if (value >= SHARED_VALUES) {
+			n = value - firstValue[var];		// Wraps around if value < firstValue[var]
+			if (n >= row[var + 1] - row[var] - SHARED_VALUES) return MAX_UNSIGNED_INT;
+			n += SHARED_VALUES;
+		}
+		return row[var] + n;
+	}
+	uint32_t getCode(unsigned int n);
+};
+
+class SASBitMatrix {					// Square bit matrix. Dense for small sizes, otherwise each row keeps only its non-empty 64-bit blocks
+friend class SASTaskCache;
+private:
+	unsigned int size;
+	bool dense;
+	unsigned int rowWords;					// Dense: number of words per row
+	std::vector<uint64_t> bits;				// Dense: rowWords words per row. Sparse: non-empty blocks grouped by row
+	std::vector<unsigned int> blockOffset;	// Sparse: first block of each row, plus a final sentinel
+	std::vector<unsigned int> blockIndex;	// Sparse: column block of each stored block, in increasing order in each row
+
+public:
+	SASBitMatrix() : size(0), dense(true), rowWords(0) {}
+	void build(unsigned int size, std::vector<std::pair<unsigned int, unsigned int>> &cells);
+	bool get(unsigned int r, unsigned int c);
+	void getRow(unsigned int r, std::vector<unsigned int>* cols);
+};
+
+class SASActionIndex {					// Lists of action indexes per (variable, value) stored in compressed sparse arrays
+friend class SASTaskCache;
+private:
+	SASFactNumbering facts;					// Slot of each (variable, value)
+	std::vector<unsigned int> offsets;		// First item of each slot, plus a final sentinel
+	std::vector<unsigned int> items;		// Action indexes, in increasing order in each slot
+	std::vector<std::pair<uint32_t, unsigned int>> pending;	// (variable-value code, action) pairs added before building the index
+
+public:
+	inline void add(unsigned int var, unsigned int value, unsigned int action) {
+		pending.emplace_back((var << 16) + value, action);
+	}
+	void build(unsigned int numVariables);
+	inline SASActionList get(unsigned int var, unsigned int value, SASAction* actions) {
+		unsigned int slot = facts.getNumber(var, value);
+		if (slot == MAX_UNSIGNED_INT) return SASActionList(nullptr, 0, actions);
+		return SASActionList(items.data() + offsets[slot], offsets[slot + 1] - offsets[slot], actions);
+	}
+};
+
 class SASConstraint {
 public:
 	char type;		// '&' = RT_AND, 'P' = RT_PREFERENCE, 'G' = RT_GOAL_PREFERENCE, 'E' = RT_AT_END, 'A' = RT_ALWAYS = 4, 'S' = RT_SOMETIME, 'W' = RT_WITHIN
@@ -152,6 +272,40 @@ public:
 	std::vector<SASMetric> terms;	// '+' | '-' | '*' | '/'
 };
 
+class SASNumericInstruction {			// Step of a compiled numeric expression
+public:
+	char op;		// 'N' = push value, 'V' = push variable, 'D' = push duration, 'M' = negate the top,
+					// '+' | '-' | '*' | '/' = combine the two topmost values, 'R' = return the top
+	uint16_t var;	// 'V'
+	float value;	// 'N'
+	SASNumericInstruction(char op, unsigned int var, float value) : op(op), var(var), value(value) {}
+};
+
+class SASNumericCode {					// Numeric expressions compiled into postfix programs stored in a contiguous array
+private:
+	std::vector<SASNumericInstruction> code;
+
+	bool compileExpression(SASNumericExpression* e, unsigned int depth);
+	bool compileMetric(SASMetric* m, unsigned int depth);
+	void foldConstants(unsigned int start);
+	unsigned int finishProgram(unsigned int start, bool compiled);
+
+public:
+	static const unsigned int STACK_SIZE = 32;	// Maximum stack depth of a compiled program
+
+	inline void clear() { code.clear(); }
+	inline unsigned int addExpression(SASNumericExpression* e) {
+		unsigned int start = code.size();
+		return finishProgram(start, compileExpression(e, 0));
+	}
+	inline unsigned int addMetric(SASMetric* m) {
+		unsigned int start = code.size();
+		return finishProgram(start, compileMetric(m, 0));
+	}
+	float evaluate(unsigned int program, float* s, float duration);
+	void evaluate(unsigned int program, float** states, unsigned int numStates, float duration, float* results);
+};
+
 class GoalDeadline {
 public:
 	float time;
@@ -159,34 +313,35 @@ public:
 };
 
 class SASTask {    
+friend class SASTaskCache;
 private:
-    std::unordered_map<TMutex, bool> mutex;
-    std::unordered_map<TVarValue, std::vector<TVarValue>*> mutexWithVarValue;
-    std::unordered_map<TMutex, bool> permanentMutex;
-    std::unordered_map<TMutex, bool> permanentMutexActions;
+    std::vector<std::pair<TVarValue, TVarValue>> mutexPairs;	// Mutex pairs added before building the mutex matrix
+    SASFactNumbering mutexFacts;					// Numbers of the (var, value) pairs in the mutex matrices
+    SASBitMatrix mutex;
+    SASBitMatrix permanentMutex;
+    bool permanentMutexActionsFound;
     std::unordered_map<std::string, unsigned int> valuesByName;
     std::vector<TVarValue> goalList;
     bool* staticNumFunctions;
     std::vector<GoalDeadline> goalDeadlines;
+    SASNumericCode numericCode;				// Compiled numeric expressions of the actions, goals and metric
+    unsigned int metricProgram;				// First instruction of the compiled metric (MAX_UNSIGNED_INT if not compiled)
 
-	inline static TMutex getMutexCode(TVariable var1, TValue value1, TVariable var2, TValue value2) {
-		TMutex code = (var1 << 16) + value1;
-        code = (code << 16) + var2;
-        code = (code << 16) + value2;
-        return code;
-    }
 	void computeActionCost(SASAction* a, bool* variablesOnMetric);
 	bool checkVariablesUsedInMetric(SASMetric* m, bool* variablesOnMetric);
 	bool checkVariableExpression(SASNumericExpression* e, bool* variablesOnMetric);
 	float computeFixedExpression(SASNumericExpression* e);
 	float evaluateMetric(SASMetric* m, float* numState, float makespan);
+	void compileNumericExpressions(SASAction* a);
 	void updateNumericState(float *s, SASNumericEffect* e, float duration);
-	bool checkActionMutex(SASAction* a1, SASAction* a2);
 	bool checkActionOrdering(SASAction* a1, SASAction* a2);
-	void computeMutexWithVarValues();
-	void checkReachability(TVarValue vv, std::unordered_map<TVarValue,bool>* goals);
-	void checkEffectReached(SASCondition* c, std::unordered_map<TVarValue,bool>* goals,
-			std::unordered_map<TVarValue, bool>* visitedVarValue, std::vector<TVarValue>* state);
+	void computeMutexMatrix();
+	void checkEffectsReached(std::vector<SASCondition> &eff, std::vector<bool> &reached, std::vector<bool> &goal,
+			unsigned int* remainingGoals, std::vector<unsigned int>* state);
+	void computePermanentMutexFacts(unsigned int first, unsigned int step, std::vector<std::pair<unsigned int, unsigned int>>* cells);
+	void addPermanentMutexCandidates(SASAction* a1, std::vector<SASCondition> &eff, std::vector<unsigned int> &stamp,
+			std::vector<unsigned int>* candidates);
+	void computePermanentMutexActions(unsigned int first, unsigned int step, std::vector<std::pair<unsigned int, unsigned int>>* pairs);
 	void addGoalToList(SASCondition* c);
 
 public:
@@ -203,15 +358,17 @@ public:
 	char metricType;								// '>' = Maximize, '<' = Minimize , 'X' = no metric specified
 	SASMetric metric;
 	bool metricDependsOnDuration;					// True if the metric depends on the plan duration
-	std::vector<SASAction*>** requirers;
-	std::vector<SASAction*>** producers;
+	SASActionIndex requirers;						// Actions that require each (var, value)
+	SASActionIndex producers;						// Actions that produce each (var, value)
 	std::vector<SASAction*> actionsWithoutConditions;
+	SASActionTable actionTable;						// Compiled conditions and effects of the actions and goals
 	TValue* initialState;							// Values of the SAS variables in the initial state
 	float* numInitialState;							// Values of the numeric variables in the initial state
 	bool variableCosts;								// True if there are actions with a cost that depends on the state
 	int numGoalsInPlateau;
 	char domainType;
 	bool tilActions;
+	std::vector< std::vector<std::string> > symmetricObjects;	// Orbits of interchangeable objects (by name), used to prune symmetric states
 
     SASTask();
 	~SASTask();
@@ -240,17 +397,26 @@ public:
 	void computeRequirers();
 	void computeProducers();
 	void computePermanentMutex();
-	void addToRequirers(TVariable v, TValue val, SASAction* a);
-	void addToProducers(TVariable v, TValue val, SASAction* a);
+	void computeNumericVariableSets();
+	void compileActionTable();
+	void compileNumericPrograms();
+	inline void compileAction(SASAction* a) {
+		a->tableRow = actionTable.addAction(a);
+		compileNumericExpressions(a);
+	}
+	inline SASActionList getRequirers(TVariable v, TValue value) { return requirers.get(v, value, actions.data()); }
+	inline SASActionList getProducers(TVariable v, TValue value) { return producers.get(v, value, actions.data()); }
 	void computeInitialActionsCost(bool keepStaticData);
 	float computeActionCost(SASAction* a, float* numState, float makespan);
 	float evaluateNumericExpression(SASNumericExpression* e, float *s, float duration);
+	void evaluateNumericExpression(SASNumericExpression* e, float** states, unsigned int numStates, float duration, float* results);
 	float getActionDuration(SASAction* a, float* s);
 	bool holdsNumericCondition(SASNumericCondition& cond, float *s, float duration);
 	inline float evaluateMetric(float* numState, float makespan) {
+		if (metricProgram != MAX_UNSIGNED_INT) return numericCode.evaluate(metricProgram, numState, makespan);
 		return evaluateMetric(&metric, numState, makespan);
 	}
-	inline bool hasPermanentMutexAction() { return !permanentMutexActions.empty(); }
+	inline bool hasPermanentMutexAction() { return permanentMutexActionsFound; }
 	std::vector<TVarValue>* getListOfGoals();
 	std::string toString();
 	inline static std::string toStringTime(char time) {
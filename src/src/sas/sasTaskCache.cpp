@@ -0,0 +1,565 @@
+/********************************************************/
+/* Binary cache of the preprocessed planning task. It   */
+/* stores the final SASTask, so repeated runs on the    */
+/* same domain and problem skip the parsing, grounding  */
+/* and SAS translation stages.                          */
+/********************************************************/
+
+#include "sasTaskCache.hpp"
+#include <fstream>
+#include <iostream>
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+using namespace std;
+
+static const char CACHE_MAGIC[8] = {'T', 'F', 'L', 'A', 'P', 'S', 'A', 'S'};
+static const uint64_t FNV_OFFSET = 14695981039346656037ULL;
+static const uint64_t FNV_PRIME = 1099511628211ULL;
+
+/********************************************************/
+/* CLASS: SASTaskCache                                  */
+/********************************************************/
+
+// Computes the key of the task and the name of its cache file
+SASTaskCache::SASTaskCache(const char* domainFileName, const char* problemFileName, bool noSAS, bool keepStaticData,
+		bool pruneIrrelevant, bool detectSymmetries) {
+	key = FNV_OFFSET;
+	hasKey = hashFile(domainFileName, &key) && hashFile(problemFileName, &key);
+	unsigned char options[5] = {(unsigned char) SAS_CACHE_VERSION, (unsigned char) noSAS, (unsigned char) keepStaticData,
+		(unsigned char) pruneIrrelevant, (unsigned char) detectSymmetries};
+	for (unsigned int i = 0; i < 5; i++)
+		key = (key ^ options[i]) * FNV_PRIME;
+	char name[32];
+	snprintf(name, sizeof(name), "tflap-%016llx.cache", (unsigned long long) key);
+	fileName = name;
+	data = nullptr;
+	size = pos = 0;
+	valid = false;
+}
+
+// Adds the contents of the file to the hash (FNV-1a). The length is also hashed to separate consecutive files
+bool SASTaskCache::hashFile(const char* name, uint64_t* hash) {
+	ifstream f(name, ios::in | ios::binary);
+	if (!f.is_open()) return false;
+	char chunk[65536];
+	uint64_t h = *hash, length = 0;
+	while (f) {
+		f.read(chunk, sizeof(chunk));
+		streamsize n = f.gcount();
+		for (streamsize i = 0; i < n; i++)
+			h = (h ^ (unsigned char) chunk[i]) * FNV_PRIME;
+		length += n;
+	}
+	for (unsigned int i = 0; i < 8; i++)
+		h = (h ^ ((length >> (i * 8)) & 0xFF)) * FNV_PRIME;
+	*hash = h;
+	return true;
+}
+
+// Loads the task from the cache file through a read-only memory mapping. Returns nullptr if there is no valid cache file
+SASTask* SASTaskCache::load() {
+	if (!hasKey) return nullptr;
+	int fd = open(fileName.c_str(), O_RDONLY);
+	if (fd < 0) return nullptr;
+	struct stat st;
+	if (fstat(fd, &st) != 0 || st.st_size < (off_t) (sizeof(CACHE_MAGIC) + sizeof(uint32_t) + sizeof(uint64_t))) {
+		close(fd);
+		return nullptr;
+	}
+	size = st.st_size;
+	void* map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED) return nullptr;
+	data = (const char*) map;
+	pos = 0;
+	valid = true;
+	char magic[sizeof(CACHE_MAGIC)];
+	readBytes(magic, sizeof(magic));
+	uint32_t version = read<uint32_t>();
+	uint64_t fileKey = read<uint64_t>();
+	SASTask* task = nullptr;
+	if (memcmp(magic, CACHE_MAGIC, sizeof(magic)) == 0 && version == SAS_CACHE_VERSION && fileKey == key) {
+		task = new SASTask();
+		readTask(task);
+		if (!valid || pos != size) {
+			cout << ";Invalid cache file " << fileName << " ignored" << endl;
+			delete task;
+			task = nullptr;
+		}
+		else task->compileNumericPrograms();		// Compiled numeric expressions are not stored in the file
+	}
+	munmap(map, size);
+	data = nullptr;
+	return task;
+}
+
+// Writes the task to the cache file. The file is written under a temporary name and then renamed,
+// so concurrent runs never read a partial file
+bool SASTaskCache::save(SASTask* task) {
+	if (!hasKey) return false;
+	buffer.clear();
+	append(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+	write<uint32_t>(SAS_CACHE_VERSION);
+	write<uint64_t>(key);
+	writeTask(task);
+	string tmpName = fileName + "." + to_string(getpid());
+	ofstream f(tmpName.c_str(), ios::out | ios::binary | ios::trunc);
+	if (!f.is_open()) return false;
+	f.write(buffer.data(), buffer.size());
+	f.close();
+	vector<char>().swap(buffer);
+	if (f.fail() || rename(tmpName.c_str(), fileName.c_str()) != 0) {
+		remove(tmpName.c_str());
+		return false;
+	}
+	return true;
+}
+
+void SASTaskCache::writeString(const string &s) {
+	write<uint32_t>(s.size());
+	append(s.data(), s.size());
+}
+
+void SASTaskCache::writeExpression(SASNumericExpression &e) {
+	write<char>(e.type);
+	write<float>(e.value);
+	write<uint16_t>(e.var);
+	write<uint32_t>(e.terms.size());
+	for (unsigned int i = 0; i < e.terms.size(); i++)
+		writeExpression(e.terms[i]);
+}
+
+void SASTaskCache::writeConditions(vector<SASCondition> &c) {
+	write<uint32_t>(c.size());
+	for (unsigned int i = 0; i < c.size(); i++) {
+		write<uint32_t>(c[i].var);
+		write<uint32_t>(c[i].value);
+		writeBool(c[i].isModified);
+	}
+}
+
+void SASTaskCache::writeNumericConditions(vector<SASNumericCondition> &c) {
+	write<uint32_t>(c.size());
+	for (unsigned int i = 0; i < c.size(); i++) {
+		write<char>(c[i].comp);
+		write<uint32_t>(c[i].terms.size());
+		for (unsigned int j = 0; j < c[i].terms.size(); j++)
+			writeExpression(c[i].terms[j]);
+	}
+}
+
+void SASTaskCache::writeNumericEffects(vector<SASNumericEffect> &e) {
+	write<uint32_t>(e.size());
+	for (unsigned int i = 0; i < e.size(); i++) {
+		write<char>(e[i].op);
+		write<uint32_t>(e[i].var);
+		writeExpression(e[i].exp);
+	}
+}
+
+void SASTaskCache::writeGoalDescription(SASGoalDescription &g) {
+	write<char>(g.time);
+	write<char>(g.type);
+	write<uint32_t>(g.var);
+	write<uint32_t>(g.value);
+	write<uint32_t>(g.terms.size());
+	for (unsigned int i = 0; i < g.terms.size(); i++)
+		writeGoalDescription(g.terms[i]);
+	write<uint32_t>(g.exp.size());
+	for (unsigned int i = 0; i < g.exp.size(); i++)
+		writeExpression(g.exp[i]);
+}
+
+void SASTaskCache::writeSignatureSet(SignatureSet &s) {
+	write<uint64_t>(s.signature);
+	writeVector(s.items);
+}
+
+void SASTaskCache::writeAction(SASAction &a) {
+	write<uint32_t>(a.index);
+	writeString(a.name);
+	write<uint32_t>(a.duration.size());
+	for (unsigned int i = 0; i < a.duration.size(); i++) {
+		write<char>(a.duration[i].time);
+		write<char>(a.duration[i].comp);
+		writeExpression(a.duration[i].exp);
+	}
+	writeConditions(a.startCond);
+	writeConditions(a.endCond);
+	writeConditions(a.overCond);
+	writeNumericConditions(a.startNumCond);
+	writeNumericConditions(a.overNumCond);
+	writeNumericConditions(a.endNumCond);
+	writeConditions(a.startEff);
+	writeConditions(a.endEff);
+	writeNumericEffects(a.startNumEff);
+	writeNumericEffects(a.endNumEff);
+	write<uint32_t>(a.preferences.size());
+	for (unsigned int i = 0; i < a.preferences.size(); i++) {
+		write<uint32_t>(a.preferences[i].index);
+		writeGoalDescription(a.preferences[i].preference);
+	}
+	writeBool(a.isGoal);
+	writeBool(a.isTIL);
+	writeBool(a.fixedDuration);
+	writeVector(a.fixedDurationValue);
+	writeBool(a.fixedCost);
+	write<float>(a.fixedCostValue);
+	writeSignatureSet(a.startNumRead);
+	writeSignatureSet(a.endNumRead);
+	writeSignatureSet(a.startNumWrite);
+	writeSignatureSet(a.endNumWrite);
+	writeSignatureSet(a.permanentMutexActions);
+	write<uint32_t>(a.tableRow);
+}
+
+void SASTaskCache::writeConstraint(SASConstraint &c) {
+	write<char>(c.type);
+	write<uint32_t>(c.terms.size());
+	for (unsigned int i = 0; i < c.terms.size(); i++)
+		writeConstraint(c.terms[i]);
+	write<uint32_t>(c.preferenceIndex);
+	write<uint32_t>(c.goal.size());
+	for (unsigned int i = 0; i < c.goal.size(); i++)
+		writeGoalDescription(c.goal[i]);
+	writeVector(c.time);
+}
+
+void SASTaskCache::writeMetric(SASMetric &m) {
+	write<char>(m.type);
+	write<float>(m.value);
+	write<uint32_t>(m.index);
+	write<uint32_t>(m.terms.size());
+	for (unsigned int i = 0; i < m.terms.size(); i++)
+		writeMetric(m.terms[i]);
+}
+
+void SASTaskCache::writeFactNumbering(SASFactNumbering &n) {
+	writeVector(n.row);
+	writeVector(n.firstValue);
+}
+
+void SASTaskCache::writeBitMatrix(SASBitMatrix &m) {
+	write<uint32_t>(m.size);
+	writeBool(m.dense);
+	write<uint32_t>(m.rowWords);
+	writeVector(m.bits);
+	writeVector(m.blockOffset);
+	writeVector(m.blockIndex);
+}
+
+void SASTaskCache::writeActionIndex(SASActionIndex &index) {
+	writeFactNumbering(index.facts);
+	writeVector(index.offsets);
+	writeVector(index.items);
+}
+
+// Writes the data computed by the preprocessing stages. The goal list and the data set by the planner are not stored
+void SASTaskCache::writeTask(SASTask* task) {
+	write<uint32_t>(task->variables.size());
+	for (unsigned int i = 0; i < task->variables.size(); i++) {
+		SASVariable &v = task->variables[i];
+		write<uint32_t>(v.index);
+		writeString(v.name);
+		writeVector(v.possibleValues);
+		writeVector(v.value);
+		writeVector(v.time);
+	}
+	write<uint32_t>(task->values.size());
+	for (unsigned int i = 0; i < task->values.size(); i++) {
+		write<uint32_t>(task->values[i].index);
+		write<uint32_t>(task->values[i].fncIndex);
+		writeString(task->values[i].name);
+	}
+	write<uint32_t>(task->numVariables.size());
+	for (unsigned int i = 0; i < task->numVariables.size(); i++) {
+		NumericVariable &v = task->numVariables[i];
+		write<uint32_t>(v.index);
+		writeString(v.name);
+		writeVector(v.value);
+		writeVector(v.time);
+	}
+	write<uint32_t>(task->actions.size());
+	for (unsigned int i = 0; i < task->actions.size(); i++)
+		writeAction(task->actions[i]);
+	write<uint32_t>(task->preferenceNames.size());
+	for (unsigned int i = 0; i < task->preferenceNames.size(); i++)
+		writeString(task->preferenceNames[i]);
+	write<uint32_t>(task->goals.size());
+	for (unsigned int i = 0; i < task->goals.size(); i++)
+		writeAction(task->goals[i]);
+	write<uint32_t>(task->constraints.size());
+	for (unsigned int i = 0; i < task->constraints.size(); i++)
+		writeConstraint(task->constraints[i]);
+	write<char>(task->metricType);
+	if (task->metricType != 'X') writeMetric(task->metric);
+	writeBool(task->metricDependsOnDuration);
+	writeActionIndex(task->requirers);
+	writeActionIndex(task->producers);
+	write<uint32_t>(task->actionsWithoutConditions.size());
+	for (unsigned int i = 0; i < task->actionsWithoutConditions.size(); i++)
+		write<uint32_t>(task->actionsWithoutConditions[i]->index);
+	write<uint32_t>(task->actionTable.facts.size());
+	append(task->actionTable.facts.data(), task->actionTable.facts.size() * sizeof(SASFact));
+	writeVector(task->actionTable.offsets);
+	append(task->initialState, task->variables.size() * sizeof(TValue));
+	append(task->numInitialState, task->numVariables.size() * sizeof(float));
+	writeBool(task->variableCosts);
+	write<int32_t>(task->numGoalsInPlateau);
+	writeFactNumbering(task->mutexFacts);
+	writeBitMatrix(task->mutex);
+	writeBitMatrix(task->permanentMutex);
+	writeBool(task->permanentMutexActionsFound);
+	writeBool(task->staticNumFunctions != nullptr);
+	if (task->staticNumFunctions != nullptr) {
+		for (unsigned int i = 0; i < task->numVariables.size(); i++)
+			writeBool(task->staticNumFunctions[i]);
+	}
+	write<uint32_t>(task->goalDeadlines.size());
+	for (unsigned int i = 0; i < task->goalDeadlines.size(); i++) {
+		write<float>(task->goalDeadlines[i].time);
+		writeVector(task->goalDeadlines[i].goals);
+	}
+	write<uint32_t>(task->symmetricObjects.size());
+	for (unsigned int i = 0; i < task->symmetricObjects.size(); i++) {
+		write<uint32_t>(task->symmetricObjects[i].size());
+		for (unsigned int j = 0; j < task->symmetricObjects[i].size(); j++)
+			writeString(task->symmetricObjects[i][j]);
+	}
+}
+
+string SASTaskCache::readString() {
+	uint32_t n = readCount(1);
+	string s(n, ' ');
+	if (n > 0) readBytes(&s[0], n);
+	return s;
+}
+
+void SASTaskCache::readExpression(SASNumericExpression &e) {
+	e.type = read<char>();
+	e.value = read<float>();
+	e.var = read<uint16_t>();
+	e.terms.resize(readCount(1));
+	for (unsigned int i = 0; i < e.terms.size(); i++)
+		readExpression(e.terms[i]);
+}
+
+void SASTaskCache::readConditions(vector<SASCondition> &c) {
+	uint32_t n = readCount(2 * sizeof(uint32_t) + 1);
+	c.reserve(n);
+	for (unsigned int i = 0; i < n; i++) {
+		unsigned int var = read<uint32_t>();
+		unsigned int value = read<uint32_t>();
+		c.emplace_back(var, value);
+		c.back().isModified = readBool();
+	}
+}
+
+void SASTaskCache::readNumericConditions(vector<SASNumericCondition> &c) {
+	c.resize(readCount(1));
+	for (unsigned int i = 0; i < c.size(); i++) {
+		c[i].comp = read<char>();
+		c[i].terms.resize(readCount(1));
+		for (unsigned int j = 0; j < c[i].terms.size(); j++)
+			readExpression(c[i].terms[j]);
+	}
+}
+
+void SASTaskCache::readNumericEffects(vector<SASNumericEffect> &e) {
+	e.resize(readCount(1));
+	for (unsigned int i = 0; i < e.size(); i++) {
+		e[i].op = read<char>();
+		e[i].var = read<uint32_t>();
+		readExpression(e[i].exp);
+	}
+}
+
+void SASTaskCache::readGoalDescription(SASGoalDescription &g) {
+	g.time = read<char>();
+	g.type = read<char>();
+	g.var = read<uint32_t>();
+	g.value = read<uint32_t>();
+	g.terms.resize(readCount(1));
+	for (unsigned int i = 0; i < g.terms.size(); i++)
+		readGoalDescription(g.terms[i]);
+	g.exp.resize(readCount(1));
+	for (unsigned int i = 0; i < g.exp.size(); i++)
+		readExpression(g.exp[i]);
+}
+
+void SASTaskCache::readSignatureSet(SignatureSet &s) {
+	s.signature = read<uint64_t>();
+	readVector(s.items);
+}
+
+void SASTaskCache::readAction(SASAction &a) {
+	a.index = read<uint32_t>();
+	a.name = readString();
+	a.duration.resize(readCount(1));
+	for (unsigned int i = 0; i < a.duration.size(); i++) {
+		a.duration[i].time = read<char>();
+		a.duration[i].comp = read<char>();
+		readExpression(a.duration[i].exp);
+	}
+	readConditions(a.startCond);
+	readConditions(a.endCond);
+	readConditions(a.overCond);
+	readNumericConditions(a.startNumCond);
+	readNumericConditions(a.overNumCond);
+	readNumericConditions(a.endNumCond);
+	readConditions(a.startEff);
+	readConditions(a.endEff);
+	readNumericEffects(a.startNumEff);
+	readNumericEffects(a.endNumEff);
+	a.preferences.resize(readCount(1));
+	for (unsigned int i = 0; i < a.preferences.size(); i++) {
+		a.preferences[i].index = read<uint32_t>();
+		readGoalDescription(a.preferences[i].preference);
+	}
+	a.isGoal = readBool();
+	a.isTIL = readBool();
+	a.fixedDuration = readBool();
+	readVector(a.fixedDurationValue);
+	a.fixedCost = readBool();
+	a.fixedCostValue = read<float>();
+	readSignatureSet(a.startNumRead);
+	readSignatureSet(a.endNumRead);
+	readSignatureSet(a.startNumWrite);
+	readSignatureSet(a.endNumWrite);
+	readSignatureSet(a.permanentMutexActions);
+	a.tableRow = read<uint32_t>();
+}
+
+void SASTaskCache::readConstraint(SASConstraint &c) {
+	c.type = read<char>();
+	c.terms.resize(readCount(1));
+	for (unsigned int i = 0; i < c.terms.size(); i++)
+		readConstraint(c.terms[i]);
+	c.preferenceIndex = read<uint32_t>();
+	c.goal.resize(readCount(1));
+	for (unsigned int i = 0; i < c.goal.size(); i++)
+		readGoalDescription(c.goal[i]);
+	readVector(c.time);
+}
+
+void SASTaskCache::readMetric(SASMetric &m) {
+	m.type = read<char>();
+	m.value = read<float>();
+	m.index = read<uint32_t>();
+	m.terms.resize(readCount(1));
+	for (unsigned int i = 0; i < m.terms.size(); i++)
+		readMetric(m.terms[i]);
+}
+
+void SASTaskCache::readFactNumbering(SASFactNumbering &n) {
+	readVector(n.row);
+	readVector(n.firstValue);
+}
+
+void SASTaskCache::readBitMatrix(SASBitMatrix &m) {
+	m.size = read<uint32_t>();
+	m.dense = readBool();
+	m.rowWords = read<uint32_t>();
+	readVector(m.bits);
+	readVector(m.blockOffset);
+	readVector(m.blockIndex);
+}
+
+void SASTaskCache::readActionIndex(SASActionIndex &index) {
+	readFactNumbering(index.facts);
+	readVector(index.offsets);
+	readVector(index.items);
+}
+
+// Reads the task in the same order it was written
+void SASTaskCache::readTask(SASTask* task) {
+	task->initialState = nullptr;
+	task->numInitialState = nullptr;
+	task->staticNumFunctions = nullptr;
+	task->variables.resize(readCount(1));
+	for (unsigned int i = 0; i < task->variables.size(); i++) {
+		SASVariable &v = task->variables[i];
+		v.index = read<uint32_t>();
+		v.name = readString();
+		readVector(v.possibleValues);
+		readVector(v.value);
+		readVector(v.time);
+	}
+	task->values.resize(readCount(1));
+	task->valuesByName.clear();
+	for (unsigned int i = 0; i < task->values.size(); i++) {
+		task->values[i].index = read<uint32_t>();
+		task->values[i].fncIndex = read<uint32_t>();
+		task->values[i].name = readString();
+		task->valuesByName[task->values[i].name] = task->values[i].index;
+	}
+	task->numVariables.resize(readCount(1));
+	for (unsigned int i = 0; i < task->numVariables.size(); i++) {
+		NumericVariable &v = task->numVariables[i];
+		v.index = read<uint32_t>();
+		v.name = readString();
+		readVector(v.value);
+		readVector(v.time);
+	}
+	task->actions.resize(readCount(1));
+	for (unsigned int i = 0; i < task->actions.size(); i++)
+		readAction(task->actions[i]);
+	task->preferenceNames.resize(readCount(1));
+	for (unsigned int i = 0; i < task->preferenceNames.size(); i++)
+		task->preferenceNames[i] = readString();
+	task->goals.resize(readCount(1));
+	for (unsigned int i = 0; i < task->goals.size(); i++)
+		readAction(task->goals[i]);
+	task->constraints.resize(readCount(1));
+	for (unsigned int i = 0; i < task->constraints.size(); i++)
+		readConstraint(task->constraints[i]);
+	task->metricType = read<char>();
+	if (task->metricType != 'X') readMetric(task->metric);
+	task->metricDependsOnDuration = readBool();
+	readActionIndex(task->requirers);
+	readActionIndex(task->producers);
+	uint32_t n = readCount(sizeof(uint32_t));
+	for (unsigned int i = 0; i < n; i++) {
+		unsigned int a = read<uint32_t>();
+		if (a >= task->actions.size()) valid = false;
+		if (!valid) return;
+		task->actionsWithoutConditions.push_back(&(task->actions[a]));
+	}
+	n = readCount(sizeof(SASFact));
+	task->actionTable.facts.reserve(n);
+	for (unsigned int i = 0; i < n; i++) {
+		uint16_t var = read<uint16_t>();
+		uint16_t value = read<uint16_t>();
+		task->actionTable.facts.emplace_back(var, value);
+	}
+	readVector(task->actionTable.offsets);
+	task->initialState = new TValue[task->variables.size()];
+	readBytes(task->initialState, task->variables.size() * sizeof(TValue));
+	task->numInitialState = new float[task->numVariables.size()];
+	readBytes(task->numInitialState, task->numVariables.size() * sizeof(float));
+	task->variableCosts = readBool();
+	task->numGoalsInPlateau = read<int32_t>();
+	readFactNumbering(task->mutexFacts);
+	readBitMatrix(task->mutex);
+	readBitMatrix(task->permanentMutex);
+	task->permanentMutexActionsFound = readBool();
+	if (readBool()) {
+		task->staticNumFunctions = new bool[task->numVariables.size()];
+		for (unsigned int i = 0; i < task->numVariables.size(); i++)
+			task->staticNumFunctions[i] = readBool();
+	}
+	task->goalDeadlines.resize(readCount(1));
+	for (unsigned int i = 0; i < task->goalDeadlines.size(); i++) {
+		task->goalDeadlines[i].time = read<float>();
+		readVector(task->goalDeadlines[i].goals);
+	}
+	task->symmetricObjects.resize(readCount(1));
+	for (unsigned int i = 0; i < task->symmetricObjects.size(); i++) {
+		task->symmetricObjects[i].resize(readCount(1));
+		for (unsigned int j = 0; j < task->symmetricObjects[i].size(); j++)
+			task->symmetricObjects[i][j] = readString();
+	}
+}
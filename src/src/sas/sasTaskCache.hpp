@@ -0,0 +1,102 @@
+#ifndef SAS_TASK_CACHE_H
+#define SAS_TASK_CACHE_H
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include "sasTask.hpp"
+
+#define SAS_CACHE_VERSION	2		// Increase when the serialized layout of SASTask changes
+
+class SASTaskCache {					// Binary copy of a preprocessed SASTask, keyed by the contents of the PDDL files
+private:
+	uint64_t key;							// Hash of the domain, the problem and the preprocessing options (including -symmetry)
+	bool hasKey;							// False if the PDDL files could not be read
+	std::string fileName;
+	std::vector<char> buffer;				// Writing: serialized task
+	const char* data;						// Reading: mapped cache file
+	size_t size;
+	size_t pos;
+	bool valid;								// Reading: false once a read goes beyond the end of the file
+
+	static bool hashFile(const char* name, uint64_t* hash);
+	inline void append(const void* p, size_t n) {
+		const char* c = (const char*) p;
+		buffer.insert(buffer.end(), c, c + n);
+	}
+	template<typename T> inline void write(T value) {
+		append(&value, sizeof(T));
+	}
+	inline void writeBool(bool b) {
+		write<uint8_t>(b ? 1 : 0);
+	}
+	template<typename T> inline void writeVector(const std::vector<T> &v) {
+		write<uint32_t>(v.size());
+		append(v.data(), v.size() * sizeof(T));
+	}
+	inline bool readBytes(void* p, size_t n) {
+		if (!valid || n > size - pos) {
+			valid = false;
+			memset(p, 0, n);
+			return false;
+		}
+		memcpy(p, data + pos, n);
+		pos += n;
+		return true;
+	}
+	template<typename T> inline T read() {
+		T value;
+		readBytes(&value, sizeof(T));
+		return value;
+	}
+	inline bool readBool() {
+		return read<uint8_t>() != 0;
+	}
+	inline uint32_t readCount(size_t itemSize) {	// Number of items of a list, checked against the remaining data
+		uint32_t n = read<uint32_t>();
+		if (valid && n > (size - pos) / itemSize) valid = false;
+		return valid ? n : 0;
+	}
+	template<typename T> inline void readVector(std::vector<T> &v) {
+		uint32_t n = readCount(sizeof(T));
+		v.resize(n);
+		readBytes(v.data(), n * sizeof(T));
+	}
+	void writeString(const std::string &s);
+	void writeExpression(SASNumericExpression &e);
+	void writeConditions(std::vector<SASCondition> &c);
+	void writeNumericConditions(std::vector<SASNumericCondition> &c);
+	void writeNumericEffects(std::vector<SASNumericEffect> &e);
+	void writeGoalDescription(SASGoalDescription &g);
+	void writeSignatureSet(SignatureSet &s);
+	void writeAction(SASAction &a);
+	void writeConstraint(SASConstraint &c);
+	void writeMetric(SASMetric &m);
+	void writeFactNumbering(SASFactNumbering &n);
+	void writeBitMatrix(SASBitMatrix &m);
+	void writeActionIndex(SASActionIndex &index);
+	void writeTask(SASTask* task);
+	std::string readString();
+	void readExpression(SASNumericExpression &e);
+	void readConditions(std::vector<SASCondition> &c);
+	void readNumericConditions(std::vector<SASNumericCondition> &c);
+	void readNumericEffects(std::vector<SASNumericEffect> &e);
+	void readGoalDescription(SASGoalDescription &g);
+	void readSignatureSet(SignatureSet &s);
+	void readAction(SASAction &a);
+	void readConstraint(SASConstraint &c);
+	void readMetric(SASMetric &m);
+	void readFactNumbering(SASFactNumbering &n);
+	void readBitMatrix(SASBitMatrix &m);
+	void readActionIndex(SASActionIndex &index);
+	void readTask(SASTask* task);
+
+public:
+	SASTaskCache(const char* domainFileName, const char* problemFileName, bool noSAS, bool keepStaticData, bool pruneIrrelevant,
+		bool detectSymmetries);
+	SASTask* load();
+	bool save(SASTask* task);
+	inline const std::string& getFileName() { return fileName; }
+};
+
+#endif
@@ -12,6 +12,7 @@
 #include "../parser/parsedTask.hpp"
 #include "../utils/utils.hpp"
 #include <iostream>
+#include <thread>
 #include <assert.h>
 using namespace std;
 
@@ -34,20 +35,27 @@ LiteralTranslation::~LiteralTranslation() {
 /* CLASS: SASTranslator                                 */
 /********************************************************/
 
+// Translates the grounded task into a SAS task. The grounded actions are consumed (released) during the translation
 SASTask* SASTranslator::translate(GroundedTask* gTask, bool onlyGenerateMutex, bool generateMutexFile, bool keepStaticData) {
     this->gTask = gTask;
     numVars = gTask->variables.size();
     numActions = gTask->actions.size();
     getInitialStateLiterals();
-    mutex = new bool*[numVars];
+    rowWords = (numVars + 63) >> 6;
+    mutex.assign((size_t) numVars * rowWords, 0);
+    literalMask.assign(rowWords, 0);
+    delMask.assign(rowWords, 0);
     for (unsigned int i = 0; i < numVars; i++)
-        mutex[i] = new bool[numVars] {false};
+        if (isLiteral[i]) literalMask[i >> 6] |= ((uint64_t) 1) << (i & 63);
     actions = new bool[numActions] {false};
+    computeLiteralActions();
+    pendingActions.assign(numActions, true);
+    mutexChanged = false;
 	
 	literalInFNA = new bool[numVars];
 	for (unsigned int i = 0; i < numVars; i++) literalInFNA[i] = literalInF[i];
 
-	while (numNewLiterals > 0 || mutexChanges.size() > 0) {
+	while (numNewLiterals > 0 || mutexChanged) {
 #ifdef DEBUG_SASTRANS_ON		
 		cout << "-----------------------------------" << endl << "4. F = {";
 		for (unsigned int i = 0; i < numVars; i++) {
@@ -58,19 +66,22 @@ SASTask* SASTranslator::translate(GroundedTask* gTask, bool onlyGenerateMutex, b
 		cout << "}" << endl << "4. M = {";
 		for (unsigned int i = 0; i < numVars; i++) {
 			for (unsigned int j = i + 1; j < numVars; j++) {
-				if (mutex[i][j]) 
+				if (isMutexLiteral(i, j)) 
 					cout << "<" << gTask->variables[i].toString(gTask->task) << "," << gTask->variables[j].toString(gTask->task) << ">";
 			}
 		}
 		cout << "}" << endl;
 #endif
-		mutexChanges.clear();
+		mutexChanged = false;
         numNewLiterals = 0;
-        for (unsigned int i = 0; i < numActions; i++) {
-            checkAction(&(gTask->actions[i]));
+        filterPendingActions();
+        for (unsigned int i = 0; i < numActions; i++) {	// Only actions whose inputs changed since their last check
+            if (pendingActions[i]) {
+                pendingActions[i] = false;
+                checkAction(&(gTask->actions[i]));
+            }
         }
-
-		for (unsigned int i = 0; i < numVars; i++) literalInFNA[i] = literalInF[i];
+		updateLiteralsInFNA();
 	}
 	delete[] literalInFNA;
     if (generateMutexFile) {
@@ -84,6 +95,8 @@ SASTask* SASTranslator::translate(GroundedTask* gTask, bool onlyGenerateMutex, b
 	sTask->computeRequirers();
 	sTask->computeProducers();
 	sTask->computePermanentMutex();
+	sTask->computeNumericVariableSets();
+	sTask->compileActionTable();
 #ifdef DEBUG_SASTRANS_ON		
 	cout << sTask->toString() << endl;
 #endif
@@ -150,7 +163,7 @@ bool SASTranslator::isMutex(GroundedCondition &c1, GroundedCondition &c2) {
 		else {												// c1 is non-negated literal
 			if (!isLiteral[c2.varIndex]) return false;
 			if (c2.valueIndex == gTask->task->CONSTANT_FALSE) return c1.varIndex == c2.varIndex;	// c2 = not c1 -> mutex 
-			return mutex[c1.varIndex][c2.varIndex];
+			return isMutexLiteral(c1.varIndex, c2.varIndex);
 		}
 	}
 	else {							// c1 is not a literal
@@ -161,9 +174,11 @@ bool SASTranslator::isMutex(GroundedCondition &c1, GroundedCondition &c2) {
 
 // Disposes the memory
 void SASTranslator::clearMemory() {
-    for (unsigned int i = 0; i < numVars; i++) 
-        delete [] mutex[i];
-    delete [] mutex;
+    vector<uint64_t>().swap(mutex);
+    vector<uint64_t>().swap(literalMask);
+    vector<uint64_t>().swap(delMask);
+    vector< vector<unsigned int> >().swap(literalActions);
+    vector<char>().swap(pendingActions);
     delete [] literalInF;
     delete [] isLiteral;
     delete [] actions;
@@ -193,27 +208,157 @@ void SASTranslator::getInitialStateLiterals() {
     }
 }
 
+// Adds the action to the list of actions affected by the changes on the given literal
+static void addLiteralAction(vector< vector<unsigned int> > &literalActions, unsigned int literal, unsigned int action) {
+	vector<unsigned int> &v = literalActions[literal];
+	if (v.empty() || v.back() != action) v.push_back(action);
+}
+
+// Indexes, for each literal, the actions that read it when they are checked: those
+// with the literal as a precondition or an add effect. The pairwise precondition check
+// in checkAction reads literals by position, so they are also indexed up to the number
+// of literal preconditions of the action
+void SASTranslator::computeLiteralActions() {
+	literalActions.clear();
+	literalActions.resize(numVars);
+	for (unsigned int i = 0; i < numActions; i++) {
+		GroundedAction* a = &(gTask->actions[i]);
+		unsigned int numPrec = 0;
+		vector<GroundedCondition>* conds[3] = {&(a->startCond), &(a->overCond), &(a->endCond)};
+		for (unsigned int k = 0; k < 3; k++) {
+			for (unsigned int j = 0; j < conds[k]->size(); j++) {
+				GroundedCondition &c = (*conds[k])[j];
+				if (isLiteral[c.varIndex] && c.valueIndex != gTask->task->CONSTANT_FALSE) {
+					addLiteralAction(literalActions, c.varIndex, i);
+					numPrec++;
+				}
+			}
+		}
+		vector<GroundedCondition>* effs[2] = {&(a->startEff), &(a->endEff)};
+		for (unsigned int k = 0; k < 2; k++) {
+			for (unsigned int j = 0; j < effs[k]->size(); j++) {
+				GroundedCondition &c = (*effs[k])[j];
+				if (isLiteral[c.varIndex] && c.valueIndex == gTask->task->CONSTANT_TRUE)
+					addLiteralAction(literalActions, c.varIndex, i);
+			}
+		}
+		for (unsigned int v = 0; v < numPrec && v < numVars; v++)
+			addLiteralAction(literalActions, v, i);
+	}
+}
+
+// FNA* <- F*, and schedules the actions that use the literals reached in the last round
+void SASTranslator::updateLiteralsInFNA() {
+	for (unsigned int i = 0; i < numVars; i++) {
+		if (literalInFNA[i] != literalInF[i]) {
+			literalInFNA[i] = literalInF[i];
+			scheduleActions(i);
+		}
+	}
+}
+
 // Checks id the given action generates new mutex
 void SASTranslator::checkAction(GroundedAction* a) {
     vector<unsigned int> preconditions;
     unsigned int startEndPrec;
+    if (getPreconditions(a, &preconditions, &startEndPrec))
+        computeMutex(a, preconditions, startEndPrec);
+}
+
+// Collects the literal preconditions of the action. Returns false if the action cannot be checked yet
+bool SASTranslator::getPreconditions(GroundedAction* a, vector<unsigned int>* preconditions, unsigned int* startEndPrec) {
     for (unsigned int i = 0; i < a->startCond.size(); i++) {
-        if (!holdsCondition(&(a->startCond[i]), &preconditions)) return;
+        if (!holdsCondition(&(a->startCond[i]), preconditions)) return false;
     }
     for (unsigned int i = 0; i < a->overCond.size(); i++) {
-        if (!holdsCondition(&(a->overCond[i]), &preconditions)) return;
+        if (!holdsCondition(&(a->overCond[i]), preconditions)) return false;
     }
-	startEndPrec = preconditions.size();
+	*startEndPrec = preconditions->size();
 	for (unsigned int i = 0; i < a->endCond.size(); i++) {
-        if (!holdsCondition(&(a->endCond[i]), &preconditions)) return;
+        if (!holdsCondition(&(a->endCond[i]), preconditions)) return false;
 	}
-    unsigned int psize = preconditions.size() > 0 ? preconditions.size() - 1 : 0;
+    unsigned int psize = preconditions->size() > 0 ? preconditions->size() - 1 : 0;
     for (unsigned int p = 0; p < psize; p++) {
-        for (unsigned int q = p + 1; q < preconditions.size(); q++) {
-            if (mutex[p][q]) return;
+        for (unsigned int q = p + 1; q < preconditions->size(); q++) {
+            if (isMutexLiteral(p, q)) return false;
         }
     }
-    computeMutex(a, preconditions, startEndPrec);
+    return true;
+}
+
+// Before a round, checks the pending actions in parallel and keeps pending only those that would
+// change F* or M*. The round then checks them sequentially in index order. An action affected by
+// a change made earlier in the round is scheduled again, so the result is that of the sequential run
+void SASTranslator::filterPendingActions() {
+	vector<unsigned int> scheduled;
+	for (unsigned int i = 0; i < numActions; i++)
+		if (pendingActions[i]) scheduled.push_back(i);
+	unsigned int numThreads = getNumThreads(scheduled.size());
+	vector<thread> threads;
+	for (unsigned int t = 1; t < numThreads; t++)
+		threads.emplace_back(&SASTranslator::filterScheduledActions, this, &scheduled, t, numThreads);
+	filterScheduledActions(&scheduled, 0, numThreads);
+	for (unsigned int t = 0; t < threads.size(); t++) threads[t].join();
+}
+
+// Filters the scheduled actions first, first + step, first + 2*step...
+void SASTranslator::filterScheduledActions(const vector<unsigned int>* scheduled, unsigned int first, unsigned int step) {
+	vector<unsigned int> preconditions;
+	vector<uint64_t> mask(rowWords, 0);
+	for (unsigned int i = first; i < scheduled->size(); i += step) {
+		unsigned int a = (*scheduled)[i];
+		pendingActions[a] = changesMutex(&(gTask->actions[a]), &preconditions, &mask);
+	}
+}
+
+// Checks, without modifying F* and M*, if checking the action would change them. Until its first
+// change, checkAction only reads F* and M*, so it is enough to look for that first change
+bool SASTranslator::changesMutex(GroundedAction* a, vector<unsigned int>* preconditions, vector<uint64_t>* mask) {
+	unsigned int startEndPrec;
+	preconditions->clear();
+	if (!getPreconditions(a, preconditions, &startEndPrec)) return false;
+	if (!actions[a->index]) return true;	// a not in A yet
+	vector<GroundedCondition>* effs[2] = {&(a->startEff), &(a->endEff)};
+	for (unsigned int k = 0; k < 2; k++) {
+		for (unsigned int j = 0; j < effs[k]->size(); j++) {
+			GroundedCondition &c = (*effs[k])[j];
+			if (isLiteral[c.varIndex] && c.valueIndex == gTask->task->CONSTANT_TRUE && !literalInF[c.varIndex])
+				return true;	// New(a) is not empty
+		}
+	}
+	for (unsigned int k = 0; k < 2; k++) {	// Del(a)
+		for (unsigned int j = 0; j < effs[k]->size(); j++) {
+			GroundedCondition &c = (*effs[k])[j];
+			if (isLiteral[c.varIndex] && c.valueIndex != gTask->task->CONSTANT_TRUE)
+				(*mask)[c.varIndex >> 6] |= ((uint64_t) 1) << (c.varIndex & 63);
+		}
+	}
+	bool changes = false;
+	for (unsigned int k = 0; k < 2 && !changes; k++) {	// L = Add(a): exists (i,q) in M* / q not in Del(a) and not exists p in Pre(a) / (p,q) in M*
+		for (unsigned int j = 0; j < effs[k]->size() && !changes; j++) {
+			GroundedCondition &c = (*effs[k])[j];
+			if (!isLiteral[c.varIndex] || c.valueIndex != gTask->task->CONSTANT_TRUE) continue;
+			const uint64_t* row = mutexRow(c.varIndex);
+			for (unsigned int w = 0; w < rowWords && !changes; w++) {
+				uint64_t word = row[w] & literalMask[w] & ~(*mask)[w];
+				while (word != 0 && !changes) {
+					unsigned int q = (w << 6) + __builtin_ctzll(word);
+					word &= word - 1;
+					changes = true;
+					for (unsigned int p = 0; p < preconditions->size(); p++) {
+						if (isMutexLiteral((*preconditions)[p], q)) {
+							changes = false;
+							break;
+						}
+					}
+				}
+			}
+		}
+	}
+	for (unsigned int k = 0; k < 2; k++)
+		for (unsigned int j = 0; j < effs[k]->size(); j++)
+			(*mask)[effs[k]->at(j).varIndex >> 6] = 0;
+	return changes;
 }
 
 // Checks if the conditions is a literal that holds in F*
@@ -263,6 +408,8 @@ void SASTranslator::computeMutex(GroundedAction* a, const vector<unsigned int> p
 	cout << "}" << endl;
 #endif 
 
+    for (unsigned int h = 0; h < del.size(); h++)
+        delMask[del[h] >> 6] |= ((uint64_t) 1) << (del[h] & 63);
     for (unsigned int f = 0; f < newA.size(); f++) {  // forall f in New(a)
 #ifdef	DEBUG_SASTRANS_ON
 		cout << "7.  |  | f = " << gTask->variables[newA[f]].toString(gTask->task) << endl;
@@ -287,24 +434,22 @@ void SASTranslator::computeMutex(GroundedAction* a, const vector<unsigned int> p
             }
         }
         for (unsigned int p = 0; p < preconditions.size(); p++) {  // p in Pre(a)
-            for (unsigned int q = 0; q < numVars; q++) {           // (p,q) in M* / q not in Del(a)
+            if (p >= startEndPrec && f < startNewEndEff) continue;  // p is at-end and f is at-start
+            const uint64_t* row = mutexRow(preconditions[p]);
+            for (unsigned int w = 0; w < rowWords; w++) {           // (p,q) in M* / q not in Del(a)
+                uint64_t word = row[w] & literalMask[w] & ~delMask[w];
+                while (word != 0) {
+                    unsigned int q = (w << 6) + __builtin_ctzll(word);
+                    word &= word - 1;
+                    if (q != newA[f]) {
 #ifdef	DEBUG_SASTRANS_ON
-				if (isLiteral[q] && q != newA[f] && mutex[preconditions[p]][q] && findInVector(q, &del) == -1) {
-					cout << "12. |  |  | p = " << gTask->variables[preconditions[p]].toString(gTask->task) << " is in Pre(a)"  << endl;
-					cout << "    |  |  | q = " << gTask->variables[q].toString(gTask->task) << " not in Del(a)" << endl;
-				}
-#endif				
-				if (isLiteral[q] && q != newA[f] && mutex[preconditions[p]][q] && 
-                    (p < startEndPrec || f >= startNewEndEff) &&   // p is at-start or over-all, or f is at-end
-                    findInVector(q, &del) == -1) {
-#ifdef	DEBUG_SASTRANS_ON
-					cout << "13. |  |  | (p, q) in M* and (time(p)<>at-end or time(f)<>at-start)" << endl;
-					cout << "14. |  |  |  | M* <- M* U {" << gTask->variables[newA[f]].toString(gTask->task) << "," << gTask->variables[q].toString(gTask->task) << "}" << endl;
+						cout << "12. |  |  | p = " << gTask->variables[preconditions[p]].toString(gTask->task) << " is in Pre(a)"  << endl;
+						cout << "    |  |  | q = " << gTask->variables[q].toString(gTask->task) << " not in Del(a)" << endl;
+						cout << "13. |  |  | (p, q) in M* and (time(p)<>at-end or time(f)<>at-start)" << endl;
+						cout << "14. |  |  |  | M* <- M* U {" << gTask->variables[newA[f]].toString(gTask->task) << "," << gTask->variables[q].toString(gTask->task) << "}" << endl;
 #endif
-					addMutex(newA[f], q);
-                    //cout << "* Mutex2: " << gTask->variables[newA[f]].toString(gTask->task) <<
-                    //     " and " << gTask->variables[q].toString(gTask->task) << " (from " <<
-					//	 gTask->variables[preconditions[p]].toString(gTask->task) << ")" << endl;
+                        addMutex(newA[f], q);
+                    }
                 }
             }
         }
@@ -316,7 +461,7 @@ void SASTranslator::computeMutex(GroundedAction* a, const vector<unsigned int> p
 		unsigned int addSize = statAddEndEff > 0 ? statAddEndEff - 1 : statAddEndEff;
 		for (unsigned int p = 0; p <= addSize; p++) {  // p,q in Add(a) / (p,q) in M*
            for (unsigned int q = p + 1; q < statAddEndEff; q++) {         
-			   if (mutex[add[p]][add[q]]) {
+			   if (isMutexLiteral(add[p], add[q])) {
 #ifdef	DEBUG_SASTRANS_ON
 				   cout << "16. |  |  | p = " << gTask->variables[add[p]].toString(gTask->task) << " in Add(a) and time(p)=at-start" << endl;
 				   cout << "    |  |  | q = " << gTask->variables[add[q]].toString(gTask->task) << " in Add(a) and time(q)=at-start" << endl;
@@ -327,9 +472,9 @@ void SASTranslator::computeMutex(GroundedAction* a, const vector<unsigned int> p
 			   }
            }
            for (unsigned int q = statAddEndEff; q < add.size(); q++) {
-			   if (mutex[add[p]][add[q]]) {
+			   if (isMutexLiteral(add[p], add[q])) {
 
-				   if (mutex[add[p]][add[q]] && findInVector(add[p], &del) == -1) {
+				   if (findInVector(add[p], &del) == -1) {
 #ifdef	DEBUG_SASTRANS_ON
 				   cout << "16. |  |  | p = " << gTask->variables[add[p]].toString(gTask->task) << " in Add(a) and time(p)=at-start" << endl;
 				   cout << "    |  |  | q = " << gTask->variables[add[q]].toString(gTask->task) << " in Add(a) and time(q)=at-end" << endl;
@@ -344,7 +489,7 @@ void SASTranslator::computeMutex(GroundedAction* a, const vector<unsigned int> p
        addSize = add.size() > 0 ? add.size() - 1 : add.size();
        for (unsigned int p = statAddEndEff; p < addSize; p++)  // p,q in Add(a) / (p,q) in M*
            for (unsigned int q = p + 1; q < add.size(); q++) {         
-			   if (mutex[add[p]][add[q]]) {
+			   if (isMutexLiteral(add[p], add[q])) {
 #ifdef	DEBUG_SASTRANS_ON
 				   cout << "16. |  |  | p = " << gTask->variables[add[p]].toString(gTask->task) << " in Add(a) and time(p)=at-end" << endl;
 				   cout << "    |  |  | q = " << gTask->variables[add[q]].toString(gTask->task) << " in Add(a) and time(q)=at-end" << endl;
@@ -366,21 +511,20 @@ void SASTranslator::computeMutex(GroundedAction* a, const vector<unsigned int> p
 #endif
     for (unsigned int i = 0; i < add.size(); i++) { // L <- Add(a) - New(a)
 		if (findInVector(add[i], &newA) == -1) {     // i in L
-			for (unsigned int q = 0; q < numVars; q++) {
+			const uint64_t* row = mutexRow(add[i]);
+			for (unsigned int w = 0; w < rowWords; w++) {	// (i,q) in M* / q not in Del(a)
+				uint64_t word = row[w] & literalMask[w] & ~delMask[w];
+				while (word != 0) {
+					unsigned int q = (w << 6) + __builtin_ctzll(word);
+					word &= word - 1;
 #ifdef	DEBUG_SASTRANS_ON
-				if (isLiteral[q] && mutex[add[i]][q]) {
 					cout << "19. |  | i = " << gTask->variables[add[i]].toString(gTask->task) << " in L" << endl;
 					cout << "    |  | q = " << gTask->variables[q].toString(gTask->task) << ", (i,q) in M*" << endl;
-				}
-#endif
-				if (isLiteral[q] && mutex[add[i]][q] &&  // (i,q) in M*
-					findInVector(q, &del) == -1) {        // q not in Del(a)
-#ifdef	DEBUG_SASTRANS_ON
 					cout << "21. |  | q not in Pre(a)" << endl;
 #endif
 					bool existsP = false;                // not exits p in Pre(a) / (p,q) in M*
 					for (unsigned p = 0; p < preconditions.size(); p++) {
-						if (mutex[preconditions[p]][q]) {
+						if (isMutexLiteral(preconditions[p], q)) {
 #ifdef	DEBUG_SASTRANS_ON
 							cout << "    |  | q " << " is mutex with p = " << gTask->variables[preconditions[p]].toString(gTask->task) << " in Pre(a)" << endl;
 #endif
@@ -399,9 +543,12 @@ void SASTranslator::computeMutex(GroundedAction* a, const vector<unsigned int> p
            }
         }
     }
+    for (unsigned int h = 0; h < del.size(); h++)
+        delMask[del[h] >> 6] = 0;
     for (unsigned int i = 0; i < newA.size(); i++) {  // F* <- F* U New(a)
         literalInF[newA[i]] = true;
         numNewLiterals++;
+        scheduleActions(newA[i]);
 #ifdef	DEBUG_SASTRANS_ON
 		cout << "23. | F* <- F* U {" << gTask->variables[newA[i]].toString(gTask->task) << "}" << endl;
 #endif
@@ -424,9 +571,13 @@ void SASTranslator::splitMutex(SASTask* sTask, bool onlyGenerateMutex) {
     }
     for (unsigned int i = 0; i < numVars; i++) {
         if (isLiteral[i]) {
-            for (unsigned int j = 0; j < numVars; j++) {
-                if (mutex[i][j] && isLiteral[j]) {
-                   graph.addAdjacent(i, j);
+            const uint64_t* row = mutexRow(i);
+            for (unsigned int w = 0; w < rowWords; w++) {
+                uint64_t word = row[w] & literalMask[w];
+                while (word != 0) {
+                   unsigned int j = (w << 6) + __builtin_ctzll(word);
+                   word &= word - 1;
+                   if (j > i) graph.addAdjacent(i, j);      // The matrix is symmetric: add each edge once
                    if (onlyGenerateMutex)
                        sTask->addMutex(i, gTask->task->CONSTANT_TRUE, j, gTask->task->CONSTANT_TRUE);
                 }
@@ -449,9 +600,15 @@ void SASTranslator::splitMutex(SASTask* sTask, bool onlyGenerateMutex) {
 	}
 	removeMultipleValues(sTask, &trans);
     setInitialValuesForVariables(sTask, &trans);					// Initial state processing
+	translateMutex(sTask, &trans);									// Mutex processing
+	vector<uint64_t>().swap(mutex);									// The literal mutex are no longer needed
  	sTask->preferenceNames = gTask->preferenceNames;
-    for (unsigned int i = 0; i < numActions; i++)					// Actions processing
+	sTask->actions.reserve(numActions);
+    for (unsigned int i = 0; i < numActions; i++) {				// Actions processing. Each grounded action is released once translated
 		createAction(&(gTask->actions[i]), sTask, &trans, false);
+		gTask->actions[i] = GroundedAction();
+	}
+	vector<GroundedAction>().swap(gTask->actions);
 	for (unsigned int i = 0; i < gTask->goals.size(); i++)			// Goals processing
 		createAction(&(gTask->goals[i]), sTask, &trans, true);
 	for (unsigned int i = 0; i < gTask->constraints.size(); i++)	// Constraints processing
@@ -459,7 +616,6 @@ void SASTranslator::splitMutex(SASTask* sTask, bool onlyGenerateMutex) {
 	sTask->metricType = gTask->metricType;							// Metric processing
 	if (sTask->metricType != 'X')
 		sTask->metric = createMetric(&(gTask->metric), &trans);
-	translateMutex(sTask, &trans);											// Mutex processing
 	delete [] negatedLiteral;
 }
 
@@ -479,11 +635,13 @@ void SASTranslator::translateMutex(SASTask* sTask, LiteralTranslation* trans) {
 	}
 	for (unsigned int i = 0; i < numVars; i++) {
 		for (unsigned int j = i + 1; j < numVars; j++) {
-			if (mutex[i][j] && sasVars[i] != MAX_UINT16 && sasVars[j] != MAX_UINT16) {
+			if (sasVars[i] != MAX_UINT16 && sasVars[j] != MAX_UINT16 && isMutexLiteral(i, j)) {
 				sTask->addMutex(sasVars[i], sasValues[i], sasVars[j], sasValues[j]);
 			}
 		}
 	}
+	delete [] sasVars;
+	delete [] sasValues;
 }
 
 void SASTranslator::removeMultipleValues(SASTask* sTask, LiteralTranslation* trans) {
@@ -569,7 +727,7 @@ void SASTranslator::checkNegatedPreconditionLiterals(GroundedAction* a) {
 void SASTranslator::updateDomain(SASTask* sTask, MutexGraph *graph, LiteralTranslation* trans) {
 	 vector<unsigned int> values;
      for (unsigned int i = 0; i < graph->numVariables(); i++) {
-         graph->getVariable(i, values, MAX_UNSIGNED_INT);
+         graph->getVariable(i, values);
          SASVariable* v;
          /*
 		 cout << "VAR " << i << endl;
@@ -1124,7 +1282,7 @@ void SASTranslator::writeMutexFile() {
     f.open("mutex.txt");
     for (unsigned int v1 = 0; v1 < numVars; v1++) {
     	for (unsigned int v2 = v1 + 1; v2 < numVars; v2++) {
-    		if (mutex[v1][v2]) {
+    		if (isMutexLiteral(v1, v2)) {
     			f << gTask->variables[v1].toString(task) << " " << gTask->variables[v2].toString(task) << endl;
 			}
 		}
@@ -17,7 +17,13 @@ public:
 class SASTranslator {
 private:
     GroundedTask* gTask;
-    bool** mutex;
+    std::vector<uint64_t> mutex;								// Literal mutex matrix: rowWords words per literal
+    std::vector<uint64_t> literalMask;							// Bit i is set if variable i is a literal
+    std::vector<uint64_t> delMask;								// Literals deleted by the action being checked
+    std::vector< std::vector<unsigned int> > literalActions;	// literal -> actions whose check reads it
+    std::vector<char> pendingActions;							// Actions to check again in the fixpoint (one byte each, written by several threads)
+    unsigned int rowWords;
+    bool mutexChanged;
     bool* actions;
     bool* isLiteral;
     bool* literalInFNA;
@@ -27,11 +33,16 @@ private:
 	unsigned int numNewLiterals;
     unsigned int numVars;
     unsigned int numActions;
-    std::unordered_map<unsigned long long, bool> mutexChanges;
 
 	void getInitialStateLiterals();
     void clearMemory();
+    void computeLiteralActions();
+    void updateLiteralsInFNA();
     void checkAction(GroundedAction *a);
+    bool getPreconditions(GroundedAction* a, std::vector<unsigned int>* preconditions, unsigned int* startEndPrec);
+    void filterPendingActions();
+    void filterScheduledActions(const std::vector<unsigned int>* scheduled, unsigned int first, unsigned int step);
+    bool changesMutex(GroundedAction* a, std::vector<unsigned int>* preconditions, std::vector<uint64_t>* mask);
     bool holdsCondition(const GroundedCondition *c, std::vector<unsigned int>* preconditions);
     void computeMutex(GroundedAction* a, const std::vector<unsigned int> preconditions, unsigned int startEndPrec);
     void splitMutex(SASTask* sTask, bool onlyGenerateMutex);
@@ -45,35 +56,28 @@ private:
 			if ((*add)[i] == value) return (int)i;
 		return -1;
 	}
-    inline unsigned long long mutexIndex(unsigned int v1, unsigned int v2) {
-        if (v1 > v2) {
-           unsigned int aux = v1;
-           v1 = v2;
-           v2 = aux;
-        }
-        return (((unsigned long long) v1) << 32) + v2;
+    inline const uint64_t* mutexRow(unsigned int v) {
+        return &mutex[(size_t) v * rowWords];
+    }
+    inline bool isMutexLiteral(unsigned int v1, unsigned int v2) {
+        return (mutex[(size_t) v1 * rowWords + (v2 >> 6)] >> (v2 & 63)) & 1;
+    }
+    inline void scheduleActions(unsigned int literal) {
+        for (unsigned int i = 0; i < literalActions[literal].size(); i++)
+            pendingActions[literalActions[literal][i]] = true;
+    }
+    inline void flipMutex(unsigned int v1, unsigned int v2) {
+        mutex[(size_t) v1 * rowWords + (v2 >> 6)] ^= ((uint64_t) 1) << (v2 & 63);
+        if (v1 != v2) mutex[(size_t) v2 * rowWords + (v1 >> 6)] ^= ((uint64_t) 1) << (v1 & 63);
+        mutexChanged = true;
+        scheduleActions(v1);
+        scheduleActions(v2);
     }
     inline void addMutex(unsigned int v1, unsigned int v2) {
-        if (!mutex[v1][v2]) {
-            mutex[v1][v2] = true;
-            mutex[v2][v1] = true;
-            unsigned long long code = mutexIndex(v1,v2);
-            std::unordered_map<unsigned long long,bool>::const_iterator got = mutexChanges.find(code);
-			if (got == mutexChanges.end() || !got->second) {
-           		mutexChanges[code] = true;
-		    }
-        }
+        if (!isMutexLiteral(v1, v2)) flipMutex(v1, v2);
     }
     inline void deleteMutex(unsigned int v1, unsigned int v2) {
-        if (mutex[v1][v2]) {
-           mutex[v1][v2] = false;
-           mutex[v2][v1] = false;
-           unsigned long long code = mutexIndex(v1,v2);
-		   std::unordered_map<unsigned long long,bool>::const_iterator got = mutexChanges.find(code);
-		   if (got == mutexChanges.end() || got->second) {
-           		mutexChanges[code] = false;
-		   }
-        }
+        if (isMutexLiteral(v1, v2)) flipMutex(v1, v2);
     }
     void updateDomain(SASTask* sTask, MutexGraph* graph, LiteralTranslation* trans);
     void simplifyDomain(SASTask* sTask, LiteralTranslation* trans);
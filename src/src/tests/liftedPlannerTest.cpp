@@ -0,0 +1,109 @@
+/********************************************************/
+/* Tests of the lifted search: estimation of the number */
+/* of ground actions, static functions, applicable      */
+/* actions in the initial state and the plan found,     */
+/* which is replayed to check that it reaches the goal. */
+/* Usage: liftedPlannerTest <domain_file> <problem_file>*/
+/********************************************************/
+
+#include <algorithm>
+#include <sstream>
+#include "test.hpp"
+#include "../parser/parser.hpp"
+#include "../preprocess/preprocess.hpp"
+#include "../grounder/grounder.hpp"
+#include "../lifted/liftedPlanner.hpp"
+using namespace std;
+
+// Returns the names of the actions applicable in the state, sorted
+vector<string> getApplicableActions(LiftedSuccessors &successors, const LiftedState &s) {
+	vector<unsigned int> candidates;
+	vector<string> names;
+	LiftedState next;
+	float duration;
+	successors.getCandidateActions(s, candidates);
+	for (unsigned int i = 0; i < candidates.size(); i++)
+		if (successors.apply(candidates[i], s, next, &duration))
+			names.push_back(successors.getActionName(candidates[i]));
+	sort(names.begin(), names.end());
+	return names;
+}
+
+// Checks the lifted task built from the fuel domain
+void testFuelTask(PreprocessedTask* prepTask) {
+	Grounder grounder;
+	CHECK(grounder.estimateNumActions(prepTask) == 40);					// fly: 2 * 4 * 4, refuel: 2 * 4
+	LiftedTask task(prepTask);
+	ParsedTask* parsedTask = prepTask->task;
+	CHECK(task.getUnsupportedFeature() == "");
+	CHECK(task.operators.size() == 2);
+	CHECK(task.goals.size() == 1);
+	CHECK(task.staticFunction[parsedTask->getFunctionIndex("dist")]);
+	CHECK(!task.staticFunction[parsedTask->getFunctionIndex("fuel")]);
+	CHECK(!task.staticFunction[parsedTask->getFunctionIndex("at")]);
+	CHECK(task.initialState.values.size() == 2);							// (at pl1 c1) and (at pl2 c2)
+	LiftedSuccessors successors(&task);
+	vector<string> applicable = getApplicableActions(successors, task.initialState);
+	vector<string> expected = {"fly pl1 c1 c2", "refuel pl1 c1", "refuel pl2 c2"};
+	CHECK(applicable == expected);
+	CHECK(!successors.isGoal(task.initialState));
+	CHECK(successors.countUnsatisfiedGoals(task.initialState) == 3);		// (at pl1 c1) already holds
+}
+
+// Checks the plan found in the fuel task: its steps are applied in order from the initial state and must reach the goal
+void testFuelPlan(PreprocessedTask* prepTask) {
+	LiftedTask task(prepTask);
+	LiftedPlanner planner(&task);
+	CHECK(planner.plan(10));
+	LiftedSuccessors &successors = planner.getSuccessors();
+	vector<unsigned int> plan;
+	planner.getPlan(plan);
+	vector<string> steps;
+	for (unsigned int i = 0; i < plan.size(); i++)
+		steps.push_back(successors.getActionName(plan[i]));
+	vector<string> expected = {"refuel pl1 c1", "fly pl1 c1 c4", "fly pl1 c4 c3", "refuel pl2 c2", "fly pl2 c2 c4",
+		"refuel pl1 c3", "fly pl1 c3 c1"};
+	CHECK(steps == expected);
+	LiftedState s = task.initialState, next;
+	bool applicable = true;
+	float duration;
+	for (unsigned int i = 0; i < plan.size() && applicable; i++) {
+		applicable = successors.apply(plan[i], s, next, &duration);
+		s = next;
+	}
+	CHECK(applicable);
+	CHECK(successors.isGoal(s));
+	istringstream pddl(planner.planToPDDL());
+	string line;
+	unsigned int numSteps = 0;
+	float end = 0;
+	bool sequential = true;
+	while (getline(pddl, line) && line[0] != ';') {
+		float start = stof(line.substr(0, line.find(':')));
+		float stepDuration = stof(line.substr(line.find('[') + 1));
+		string name = line.substr(line.find('(') + 1, line.find(')') - line.find('(') - 1);
+		CHECK(numSteps < steps.size() && name == steps[numSteps]);
+		if (start <= end) sequential = false;
+		end = start + stepDuration;
+		numSteps++;
+	}
+	CHECK(numSteps == steps.size());
+	CHECK(sequential);
+}
+
+int main(int argc, char* argv[]) {
+	if (argc < 3) {
+		cout << "Usage: liftedPlannerTest <domain_file> <problem_file>" << endl;
+		return 2;
+	}
+	Parser parser;
+	ParsedTask* parsedTask = parser.parseDomain(argv[1]);
+	parser.parseProblem(argv[2]);
+	Preprocess preprocess;
+	PreprocessedTask* prepTask = preprocess.preprocessTask(parsedTask);
+	testFuelTask(prepTask);
+	testFuelPlan(prepTask);
+	delete prepTask;
+	delete parsedTask;
+	return testResult("liftedPlannerTest");
+}
@@ -0,0 +1,142 @@
+/********************************************************/
+/* Tests of the compiled numeric expressions: postfix   */
+/* compilation, constant folding, single and batch      */
+/* evaluation, and the expressions that are left to     */
+/* the interpreter.                                     */
+/********************************************************/
+
+#include "test.hpp"
+#include "../sas/sasTask.hpp"
+using namespace std;
+
+SASNumericExpression expression(char type, float value, uint16_t var, vector<SASNumericExpression> terms) {
+	SASNumericExpression e;
+	e.type = type;
+	e.value = value;
+	e.var = var;
+	e.terms = terms;
+	return e;
+}
+
+SASNumericExpression number(float value) {
+	return expression('N', value, 0, {});
+}
+
+SASNumericExpression variable(uint16_t var) {
+	return expression('V', 0, var, {});
+}
+
+SASNumericExpression duration() {
+	return expression('D', 0, 0, {});
+}
+
+SASNumericExpression operation(char type, vector<SASNumericExpression> terms) {
+	return expression(type, 0, 0, terms);
+}
+
+SASMetric metricTerm(char type, float value, unsigned int index, vector<SASMetric> terms) {
+	SASMetric m;
+	m.type = type;
+	m.value = value;
+	m.index = index;
+	m.terms = terms;
+	return m;
+}
+
+// Reference evaluation of an expression tree, as done by the interpreter of SASTask
+float interpret(SASNumericExpression &e, float* s, float duration) {
+	switch (e.type) {
+	case 'N':	return e.value;
+	case 'V':	return s[e.var];
+	case 'D':	return duration;
+	}
+	float res = interpret(e.terms[0], s, duration);
+	for (unsigned int i = 1; i < e.terms.size(); i++) {
+		float v = interpret(e.terms[i], s, duration);
+		switch (e.type) {
+		case '+':	res += v;	break;
+		case '-':	res -= v;	break;
+		case '*':	res *= v;	break;
+		default:	res /= v;	break;
+		}
+	}
+	return res;
+}
+
+// Programs are stored one after another, so the size of the last one is the distance to the next free position
+unsigned int programSize(SASNumericCode &code, unsigned int program) {
+	SASNumericExpression next = number(0);
+	return code.addExpression(&next) - program;
+}
+
+void testConstantFolding() {
+	SASNumericCode code;
+	SASNumericExpression e = operation('+', {operation('*', {number(2), number(3.5f)}),
+		operation('/', {number(9), number(4)}), operation('-', {number(1), number(5), number(0.25f)})});
+	unsigned int program = code.addExpression(&e);
+	CHECK(program == 0);
+	CHECK(code.evaluate(program, nullptr, 0) == interpret(e, nullptr, 0));	// No access to the state
+	CHECK(programSize(code, program) == 2);									// Folded into a push and a return
+	SASNumericExpression f = operation('*', {variable(1), operation('+', {number(1), number(2)})});
+	program = code.addExpression(&f);
+	CHECK(programSize(code, program) == 4);									// Only the constant subtree is folded
+	float s[2] = {0, 2.5f};
+	CHECK(code.evaluate(program, s, 0) == 7.5f);
+}
+
+void testEvaluation() {
+	SASNumericCode code;
+	vector<SASNumericExpression> expressions = {
+		operation('-', {variable(0), variable(1), variable(2)}),
+		operation('/', {operation('*', {duration(), variable(0)}), operation('+', {variable(2), number(1)})}),
+		operation('+', {operation('-', {number(10), variable(1)}), operation('*', {number(0.5f), duration()})}),
+		variable(2)
+	};
+	float states[3][3] = {{7, 2, 1}, {-3.5f, 0.25f, 8}, {100, 50, 25}};
+	float* statePtrs[3] = {states[0], states[1], states[2]};
+	for (unsigned int i = 0; i < expressions.size(); i++) {
+		unsigned int program = code.addExpression(&(expressions[i]));
+		CHECK(program != MAX_UNSIGNED_INT);
+		float results[3];
+		code.evaluate(program, statePtrs, 3, 4, results);
+		for (unsigned int j = 0; j < 3; j++) {
+			float expected = interpret(expressions[i], states[j], 4);
+			CHECK(code.evaluate(program, states[j], 4) == expected);
+			CHECK(results[j] == expected);
+		}
+	}
+}
+
+void testMetric() {
+	SASNumericCode code;
+	SASMetric fluent = metricTerm('F', 0, 1, {});
+	SASMetric metric = metricTerm('+', 0, 0, {metricTerm('T', 0, 0, {}),
+		metricTerm('*', 0, 0, {metricTerm('N', 0.5f, 0, {}), fluent})});
+	unsigned int program = code.addMetric(&metric);
+	float s[2] = {3, 8};
+	CHECK(program != MAX_UNSIGNED_INT);
+	CHECK(code.evaluate(program, s, 12) == 16);								// Makespan + 0.5 * fluent
+	SASMetric negation = metricTerm('-', 0, 0, {fluent});
+	program = code.addMetric(&negation);
+	CHECK(code.evaluate(program, s, 0) == -8);
+}
+
+void testNotCompiled() {
+	SASNumericCode code;
+	SASNumericExpression sharpT = operation('#', {number(1)});
+	CHECK(code.addExpression(&sharpT) == MAX_UNSIGNED_INT);
+	SASNumericExpression deep = variable(0);
+	for (unsigned int i = 0; i < SASNumericCode::STACK_SIZE + 1; i++)
+		deep = operation('+', {number(1), deep});
+	CHECK(code.addExpression(&deep) == MAX_UNSIGNED_INT);					// Too deep for the evaluation stack
+	SASNumericExpression e = variable(0);
+	CHECK(code.addExpression(&e) == 0);										// Failed programs leave no code
+}
+
+int main() {
+	testConstantFolding();
+	testEvaluation();
+	testMetric();
+	testNotCompiled();
+	return testResult("numericCodeTest");
+}
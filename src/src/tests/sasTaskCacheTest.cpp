@@ -0,0 +1,123 @@
+/********************************************************/
+/* Round-trip test of the binary SASTask cache: the     */
+/* task loaded from the cache file must be equal to the */
+/* one produced by the full preprocessing pipeline.     */
+/* Usage: sasTaskCacheTest <domain_file> <problem_file> */
+/********************************************************/
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include "test.hpp"
+#include "../parser/parser.hpp"
+#include "../preprocess/preprocess.hpp"
+#include "../grounder/grounder.hpp"
+#include "../sas/sasTranslator.hpp"
+#include "../sas/sasTaskCache.hpp"
+using namespace std;
+
+// Runs the preprocessing stages on the given files
+SASTask* buildTask(char* domainFileName, char* problemFileName) {
+	Parser parser;
+	ParsedTask* parsedTask = parser.parseDomain(domainFileName);
+	parser.parseProblem(problemFileName);
+	Preprocess preprocess;
+	PreprocessedTask* prepTask = preprocess.preprocessTask(parsedTask);
+	Grounder grounder;
+	GroundedTask* gTask = grounder.groundTask(prepTask, false, false);
+	delete prepTask;
+	SASTranslator translator;
+	SASTask* sTask = translator.translate(gTask, false, false, false);
+	delete gTask;
+	delete parsedTask;
+	return sTask;
+}
+
+// Returns a string with the data of the task that is not included in SASTask::toString
+string getTaskData(SASTask* task) {
+	string s;
+	unsigned int numVars = task->variables.size();
+	for (unsigned int v1 = 0; v1 < numVars; v1++) {
+		s += to_string(task->initialState[v1]) + ";";
+		for (unsigned int a : task->variables[v1].possibleValues) {
+			SASActionList req = task->getRequirers(v1, a), prod = task->getProducers(v1, a);
+			s += "R";
+			for (unsigned int i = 0; i < req.size(); i++) s += " " + to_string(req[i]->index);
+			s += "P";
+			for (unsigned int i = 0; i < prod.size(); i++) s += " " + to_string(prod[i]->index);
+			for (unsigned int v2 = 0; v2 < numVars; v2++)
+				for (unsigned int b : task->variables[v2].possibleValues) {
+					if (task->isMutex(v1, a, v2, b)) s += "M";
+					if (task->isPermanentMutex(v1, a, v2, b)) s += "Q";
+				}
+		}
+	}
+	for (unsigned int i = 0; i < task->numVariables.size(); i++)
+		s += to_string(task->numInitialState[i]) + ";";
+	for (unsigned int i = 0; i < task->actions.size(); i++) {
+		SASAction* a = &(task->actions[i]);
+		s += to_string(a->fixedCostValue) + "," + to_string(a->tableRow) + (a->fixedDuration ? "F" : "V");
+		for (unsigned int j = 0; j < task->actions.size(); j++)
+			if (task->isPermanentMutex(a, &(task->actions[j]))) s += " " + to_string(j);
+		s += ";";
+	}
+	for (unsigned int i = 0; i < task->actionTable.facts.size(); i++)
+		s += to_string(task->actionTable.facts[i].var) + ":" + to_string(task->actionTable.facts[i].value) + " ";
+	s += to_string(task->actionsWithoutConditions.size()) + to_string(task->hasPermanentMutexAction()) +
+		to_string(task->variableCosts) + to_string(task->metricDependsOnDuration);
+	return s;
+}
+
+// Checks that the durations and the metric are evaluated to the same values in both tasks
+void checkNumericEvaluation(SASTask* t1, SASTask* t2) {
+	for (unsigned int i = 0; i < t1->actions.size(); i++) {
+		CHECK(t1->getActionDuration(&(t1->actions[i]), t1->numInitialState) ==
+			t2->getActionDuration(&(t2->actions[i]), t2->numInitialState));
+	}
+	CHECK(t1->evaluateMetric(t1->numInitialState, 10) == t2->evaluateMetric(t2->numInitialState, 10));
+}
+
+// Overwrites the file with its first half
+void truncateFile(const string &fileName) {
+	ifstream in(fileName.c_str(), ios::in | ios::binary);
+	string content((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+	in.close();
+	ofstream out(fileName.c_str(), ios::out | ios::binary | ios::trunc);
+	out.write(content.data(), content.size() / 2);
+}
+
+int main(int argc, char* argv[]) {
+	if (argc < 3) {
+		cout << "Usage: sasTaskCacheTest <domain_file> <problem_file>" << endl;
+		return 2;
+	}
+	SASTask* task = buildTask(argv[1], argv[2]);
+	CHECK(task != nullptr);
+	if (task == nullptr) return testResult("sasTaskCacheTest");
+	task->symmetricObjects = {{"pl1", "pl2"}, {"c1", "c3", "c4"}};		// Any orbits are enough to check that they are stored
+	SASTaskCache writer(argv[1], argv[2], false, false, false, false);
+	remove(writer.getFileName().c_str());
+	CHECK(writer.load() == nullptr);								// No cache file yet
+	CHECK(writer.save(task));
+	SASTaskCache reader(argv[1], argv[2], false, false, false, false);
+	SASTask* loaded = reader.load();
+	CHECK(loaded != nullptr);
+	if (loaded != nullptr) {
+		CHECK(loaded->toString() == task->toString());
+		CHECK(getTaskData(loaded) == getTaskData(task));
+		checkNumericEvaluation(task, loaded);
+		CHECK(loaded->symmetricObjects == task->symmetricObjects);
+		delete loaded;
+	}
+	SASTaskCache otherOptions(argv[1], argv[2], false, true, false, false);
+	CHECK(otherOptions.getFileName() != writer.getFileName());	// The options are part of the key
+	CHECK(otherOptions.load() == nullptr);
+	SASTaskCache withSymmetry(argv[1], argv[2], false, false, false, true);
+	CHECK(withSymmetry.getFileName() != writer.getFileName());		// A task without orbits is not reused with -symmetry
+	truncateFile(writer.getFileName());
+	SASTaskCache truncated(argv[1], argv[2], false, false, false, false);
+	CHECK(truncated.load() == nullptr);							// Incomplete files are rejected
+	remove(writer.getFileName().c_str());
+	delete task;
+	return testResult("sasTaskCacheTest");
+}
@@ -0,0 +1,29 @@
+#ifndef TEST_H
+#define TEST_H
+
+/********************************************************/
+/* Minimal support for the unit tests: failed checks    */
+/* are reported and counted, and the test program       */
+/* returns a non-zero status if any of them failed.     */
+/********************************************************/
+
+#include <iostream>
+
+static unsigned int numChecks = 0;
+static unsigned int numFailedChecks = 0;
+
+#define CHECK(condition) { \
+	numChecks++; \
+	if (!(condition)) { \
+		numFailedChecks++; \
+		std::cout << __FILE__ << ":" << __LINE__ << ": check failed: " << #condition << std::endl; \
+	} \
+}
+
+// Prints the summary of the test and returns the exit status of the test program
+static inline int testResult(const char* testName) {
+	std::cout << testName << ": " << (numChecks - numFailedChecks) << "/" << numChecks << " checks passed" << std::endl;
+	return numFailedChecks == 0 ? 0 : 1;
+}
+
+#endif
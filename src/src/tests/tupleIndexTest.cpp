@@ -0,0 +1,70 @@
+/********************************************************/
+/* Tests of the tuple-keyed hash table used by the      */
+/* grounder to index variables and actions.             */
+/********************************************************/
+
+#include <map>
+#include <random>
+#include "test.hpp"
+#include "../grounder/grounder.hpp"
+using namespace std;
+
+void testEmptyIndex() {
+	GrounderTupleIndex index;
+	CHECK(index.find({}) == MAX_UNSIGNED_INT);
+	CHECK(index.find({0, 1}) == MAX_UNSIGNED_INT);
+}
+
+// Keys that share a prefix or differ only in length must be kept apart
+void testSimilarKeys() {
+	GrounderTupleIndex index;
+	index.insert({}, 10);
+	index.insert({0}, 11);
+	index.insert({0, 0}, 12);
+	index.insert({1, 2}, 13);
+	index.insert({2, 1}, 14);
+	index.insert({1, 2, 0}, 15);
+	CHECK(index.find({}) == 10);
+	CHECK(index.find({0}) == 11);
+	CHECK(index.find({0, 0}) == 12);
+	CHECK(index.find({1, 2}) == 13);
+	CHECK(index.find({2, 1}) == 14);
+	CHECK(index.find({1, 2, 0}) == 15);
+	CHECK(index.find({0, 0, 0}) == MAX_UNSIGNED_INT);
+	CHECK(index.find({1}) == MAX_UNSIGNED_INT);
+	index.insert({1, 2}, 20);											// Existing keys get the new value
+	CHECK(index.find({1, 2}) == 20);
+	CHECK(index.find({1, 2, 0}) == 15);
+}
+
+// Compares the index with a map after many insertions, which force the table to grow several times
+void testManyKeys() {
+	GrounderTupleIndex index;
+	map<vector<unsigned int>, unsigned int> reference;
+	mt19937 generator(2015);
+	vector<unsigned int> key;
+	for (unsigned int i = 0; i < 20000; i++) {
+		key.resize(1 + generator() % 4);
+		for (unsigned int j = 0; j < key.size(); j++)
+			key[j] = generator() % 40;
+		index.insert(key, i);
+		reference[key] = i;
+	}
+	unsigned int wrong = 0;
+	for (auto it = reference.begin(); it != reference.end(); ++it)
+		if (index.find(it->first) != it->second) wrong++;
+	CHECK(wrong == 0);
+	CHECK(index.find({40}) == MAX_UNSIGNED_INT);
+	CHECK(index.find({0, 0, 0, 0, 0}) == MAX_UNSIGNED_INT);
+	index.clear();
+	CHECK(index.find(reference.begin()->first) == MAX_UNSIGNED_INT);
+	index.insert({3, 4}, 7);											// The index is reusable after clearing it
+	CHECK(index.find({3, 4}) == 7);
+}
+
+int main() {
+	testEmptyIndex();
+	testSimilarKeys();
+	testManyKeys();
+	return testResult("tupleIndexTest");
+}
@@ -9,12 +9,16 @@
 #include <iostream>
 #include <time.h>
 #include <string.h>
+#include <stdlib.h>
 #include "parser/parser.hpp"
 #include "preprocess/preprocess.hpp"
+#include "preprocess/symmetry.hpp"
 #include "grounder/grounder.hpp"
 #include "sas/sasTranslator.hpp"
+#include "sas/sasTaskCache.hpp"
 #include "planner/plan.hpp"
 #include "planner/plannerSetting.hpp"
+#include "lifted/liftedPlanner.hpp"
 using namespace std;
 
 #define _TRACE_OFF_
@@ -35,10 +39,16 @@ struct PlannerParameters
     bool noSAS;
     bool generateMutexFile;
     bool generateTrace;
+    bool useCache;
+    bool pruneIrrelevant;
+    bool detectSymmetries;
+    double maxGroundActions;    // The lifted search is used if the estimated number of actions exceeds this limit (0 = no limit)
+    int exitStatus;
     PlannerParameters() : total_time(0), domainFileName(nullptr),
            problemFileName(nullptr), outputFileName(nullptr), generateGroundedDomain(false), 
            keepStaticData(false), noSAS(false), generateMutexFile(false),
-		   generateTrace(false) {}
+		   generateTrace(false), useCache(false), pruneIrrelevant(false),
+		   detectSymmetries(false), maxGroundActions(0), exitStatus(0) {}
 };
 
 // Parses the domain and problem files
@@ -58,6 +68,26 @@ ParsedTask* parseStage(PlannerParameters *parameters) {
     return parsedTask;
 }
 
+// Detects the symmetric objects of the parsed task, reports the orbits found and returns them (by object name)
+vector< vector<string> > symmetryStage(ParsedTask* parsedTask, PlannerParameters *parameters) {
+    clock_t t = clock();
+    SymmetryDetector detector;
+    detector.detectSymmetries(parsedTask);
+    float time = toSeconds(t);
+    parameters->total_time += time;
+    #ifdef _TIME_ON_
+        cout << ";Symmetry detection time: " << time << endl;
+    #endif
+    cout << ";" << detector.getOrbits().size() << " object orbits found (" << detector.getNumSymmetricObjects() <<
+        " symmetric objects)" << endl;
+    const vector< vector<unsigned int> > &orbits = detector.getOrbits();
+    vector< vector<string> > orbitNames(orbits.size());
+    for (unsigned int i = 0; i < orbits.size(); i++)
+        for (unsigned int j = 0; j < orbits[i].size(); j++)
+            orbitNames[i].push_back(parsedTask->objects[orbits[i][j]].name);
+    return orbitNames;
+}
+
 // Preprocesses the parsed task
 PreprocessedTask* preprocessStage(ParsedTask* parsedTask, PlannerParameters *parameters) {
     clock_t t = clock();
@@ -74,11 +104,56 @@ PreprocessedTask* preprocessStage(ParsedTask* parsedTask, PlannerParameters *par
     return prepTask;
 }
 
+// Checks if the estimated number of ground actions exceeds the grounding limit
+bool exceedsGroundingLimit(PreprocessedTask* prepTask, PlannerParameters *parameters) {
+    if (parameters->maxGroundActions <= 0) return false;
+    Grounder grounder;
+    double numActions = grounder.estimateNumActions(prepTask);
+    if (numActions <= parameters->maxGroundActions) return false;
+    cout << ";Warning: estimated " << numActions << " ground actions exceed the grounding limit (" <<
+        parameters->maxGroundActions << "). The lifted search is used instead of the grounded planner" << endl;
+    return true;
+}
+
+// Searches for a plan on the lifted task, without grounding it. The plan is sequential and is not optimized for
+// the metric. Returns false if no plan is found
+bool liftedPlanningStage(PreprocessedTask* prepTask, PlannerParameters *parameters) {
+    clock_t t = clock();
+    LiftedTask task(prepTask);
+    string feature = task.getUnsupportedFeature();
+    if (!feature.empty()) {
+        cout << ";Error: the lifted search does not support " << feature << endl;
+        return false;
+    }
+    cout << ";Warning: the lifted search returns a sequential plan, without concurrent actions" << endl;
+    if (prepTask->task->metricType != MT_NONE || prepTask->task->hasPreferences())
+        cout << ";Warning: the lifted search ignores the metric and the preferences" << endl;
+    LiftedPlanner planner(&task);
+    if (!planner.plan(TIMEOUT - toSeconds(startTime))) {
+        cout << ";Error: the lifted search did not find a plan" << endl;
+        return false;
+    }
+    #ifdef _TIME_ON_
+        cout << ";" << planner.getNumGroundActions() << " ground actions instantiated by the lifted search" << endl;
+    #endif
+    std::ofstream solFile;
+    char fname[256];
+    snprintf(fname, sizeof(fname), "%s.1", parameters->outputFileName);
+    solFile.open(fname);
+    float time = toSeconds(t);
+    solFile << planner.planToPDDL();
+    solFile << ";Planning time: " << time << endl;
+    solFile << ";Total time: " << (time + parameters->total_time) << endl;
+    solFile << ";" << planner.getExpandedNodes() << " expanded nodes" << endl;
+    solFile.close();
+    return true;
+}
+
 // Grounder stage of the preprocessed task
 GroundedTask* groundingStage(PreprocessedTask* prepTask, PlannerParameters *parameters) {
     clock_t t = clock();
     Grounder grounder;
-    GroundedTask* gTask = grounder.groundTask(prepTask, parameters->keepStaticData);
+    GroundedTask* gTask = grounder.groundTask(prepTask, parameters->keepStaticData, parameters->pruneIrrelevant);
     float time = toSeconds(t);
     parameters->total_time += time;
 #ifdef _TRACE_ON_
@@ -87,6 +162,10 @@ GroundedTask* groundingStage(PreprocessedTask* prepTask, PlannerParameters *para
     #ifdef _TIME_ON_
         cout << ";Grounding time: " << time << endl;
     #endif
+    if (parameters->pruneIrrelevant) {
+        cout << ";" << grounder.getNumIrrelevantActions() << " irrelevant actions and " <<
+            grounder.getNumIrrelevantVariables() << " irrelevant variables removed" << endl;
+    }
     if (parameters->generateGroundedDomain) {
         cout << ";" << gTask->actions.size() << " grounded actions" << endl;
         gTask->writePDDLDomain();
@@ -95,6 +174,19 @@ GroundedTask* groundingStage(PreprocessedTask* prepTask, PlannerParameters *para
     return gTask;
 }
 
+// Prints the number of SAS variables and the sizes of their domains
+void printSASStatistics(SASTask* sasTask) {
+    unsigned int numVars = sasTask->variables.size(), numValues = 0, maxValues = 0, numBinary = 0;
+    for (unsigned int i = 0; i < numVars; i++) {
+        unsigned int size = sasTask->variables[i].possibleValues.size();
+        numValues += size;
+        if (size > maxValues) maxValues = size;
+        if (size <= 2) numBinary++;
+    }
+    cout << ";" << numVars << " SAS variables (" << numBinary << " binary), domain size avg. " <<
+        (numVars == 0 ? 0.0f : numValues / (float) numVars) << ", max. " << maxValues << endl;
+}
+
 // SAS translation stage
 SASTask* sasTranslationStage(GroundedTask* gTask, PlannerParameters *parameters) {
     clock_t t = clock();
@@ -105,6 +197,7 @@ SASTask* sasTranslationStage(GroundedTask* gTask, PlannerParameters *parameters)
     parameters->total_time += time;
     #ifdef _TIME_ON_
         cout << ";SAS translation time: " << time << endl;
+        printSASStatistics(sasTask);
     #endif
 	#ifdef _TRACE_ON_
         cout << sasTask->toString() << endl;
@@ -116,19 +209,48 @@ SASTask* sasTranslationStage(GroundedTask* gTask, PlannerParameters *parameters)
 SASTask* doPreprocess(PlannerParameters *parameters) {
 	parameters->total_time = 0;
 	SASTask* sTask = nullptr;
+	SASTaskCache* cache = nullptr;
+	if (parameters->useCache) {
+		clock_t t = clock();
+		cache = new SASTaskCache(parameters->domainFileName, parameters->problemFileName, parameters->noSAS, parameters->keepStaticData,
+			parameters->pruneIrrelevant, parameters->detectSymmetries);
+		if (!parameters->generateGroundedDomain && !parameters->generateMutexFile)	// These files are only generated by the full pipeline
+			sTask = cache->load();
+		if (sTask != nullptr) {
+			parameters->total_time = toSeconds(t);
+			#ifdef _TIME_ON_
+				cout << ";Cache loading time: " << parameters->total_time << endl;
+			#endif
+			if (parameters->detectSymmetries)		// The orbits are stored in the cache file
+				cout << ";" << sTask->symmetricObjects.size() << " object orbits loaded from the cache" << endl;
+			delete cache;
+			return sTask;
+		}
+	}
     ParsedTask* parsedTask = parseStage(parameters);
     if (parsedTask != nullptr) {
+    	vector< vector<string> > orbits;
+    	if (parameters->detectSymmetries) orbits = symmetryStage(parsedTask, parameters);
     	PreprocessedTask* prepTask = preprocessStage(parsedTask, parameters);
-        if (prepTask != nullptr) {
+        if (prepTask != nullptr && exceedsGroundingLimit(prepTask, parameters)) {
+            if (!liftedPlanningStage(prepTask, parameters)) parameters->exitStatus = 1;
+            delete prepTask;
+        } else if (prepTask != nullptr) {
         	GroundedTask* gTask = groundingStage(prepTask, parameters);
+            delete prepTask;				// The grounded task only refers to the parsed task
             if (gTask != nullptr) {
             	sTask = sasTranslationStage(gTask, parameters);
+            	if (sTask != nullptr) sTask->symmetricObjects.swap(orbits);
                 delete gTask;       
             }
-            delete prepTask;
         }
         delete parsedTask;
     }
+    if (cache != nullptr) {
+    	if (sTask != nullptr && !cache->save(sTask))
+    		cout << ";Unable to write the cache file " << cache->getFileName() << endl;
+    	delete cache;
+    }
     return sTask;
 }
 
@@ -180,12 +302,16 @@ void startPlanning(PlannerParameters *parameters) {
 
 // Prints the command-line arguments of the planner
 void printUsage() {
-     cout << "Usage: tflap <domain_file> <problem_file> <output_file> [-ground] [-static] [-mutex] [-trace]" << endl;
+     cout << "Usage: tflap <domain_file> <problem_file> <output_file> [-ground] [-static] [-mutex] [-trace] [-cache] [-relevance] [-symmetry] [-maxground <n>]" << endl;
      cout << " -ground: generates the GroundedDomain.pddl and GroundedProblem.pddl files." << endl;
      cout << " -static: keeps the static data in the planning task." << endl;
      cout << " -nsas: does not make translation to SAS (finite-domain variables)." << endl;
      cout << " -mutex: generates the mutex.txt file with the list of static mutex facts." << endl; 
 	 cout << " -trace: generates the trace.txt file with the search tree." << endl;
+	 cout << " -cache: reuses the preprocessed task stored by a previous run on the same files (tflap-<hash>.cache)." << endl;
+	 cout << " -relevance: removes the actions and variables that are not relevant for the goals." << endl;
+	 cout << " -symmetry: reports the orbits of symmetric (interchangeable) objects and prunes the states that are symmetric to a visited one." << endl;
+	 cout << " -maxground <n>: plans on the lifted task, without grounding it, if the estimated number of ground actions exceeds n (sequential plan, metric and preferences ignored)." << endl;
 }
 
 // Compare two strings
@@ -217,12 +343,19 @@ int main(int argc, char* argv[]) {
             else if (compareStr(argv[param], "-nsas")) parameters.noSAS = true;
             else if (compareStr(argv[param], "-mutex")) parameters.generateMutexFile = true;
 	    else if (compareStr(argv[param], "-trace")) parameters.generateTrace = true;
+	    else if (compareStr(argv[param], "-cache")) parameters.useCache = true;
+	    else if (compareStr(argv[param], "-relevance")) parameters.pruneIrrelevant = true;
+	    else if (compareStr(argv[param], "-symmetry")) parameters.detectSymmetries = true;
+	    else if (compareStr(argv[param], "-maxground") && param + 1 < argc) parameters.maxGroundActions = atof(argv[++param]);
 	    else { parameters.domainFileName = nullptr; break; }
          }
          param++;
        }
        if (parameters.domainFileName == nullptr || parameters.problemFileName == nullptr) printUsage();
-       else startPlanning(&parameters);
+       else {
+           startPlanning(&parameters);
+           return parameters.exitStatus;
+       }
     }
     return 0;
 }
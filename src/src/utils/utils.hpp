@@ -2,6 +2,7 @@
 #define UTILS_H
 #include <limits>
 #include <cstdint>
+#include <thread>
 
 #define DOMAIN_CONCURRENT	0
 #define DOMAIN_DEAD_ENDS	1
@@ -20,6 +21,8 @@
 #define SEARCH_PLATEAU		32
 #define SEARCH_MASK_PLATEAU	31
 
+#define MIN_ITEMS_PER_THREAD	256		// Minimum number of items to process by each thread in parallel loops
+
 const float 		EPSILON 			= 0.002f;
 const unsigned int 	MAX_UNSIGNED_INT 	= std::numeric_limits<unsigned int>::max();
 const int32_t 		MAX_INT32 			= std::numeric_limits<int32_t>::max();
@@ -34,6 +37,13 @@ typedef uint16_t	TStep;
 typedef uint16_t	TVariable;
 typedef uint16_t	TValue;
 
+inline unsigned int getNumThreads(unsigned int numItems) {	// Number of threads to use in a loop over the given number of items
+	unsigned int n = std::thread::hardware_concurrency();
+	unsigned int maxThreads = numItems / MIN_ITEMS_PER_THREAD + 1;
+	if (n == 0) n = 1;
+	return n < maxThreads ? n : maxThreads;
+}
+
 inline TTimePoint stepToStartPoint(TStep step) {	// Step number -> start time point
 	return step << 1;
 }